@@ -7,7 +7,9 @@
         "src/connection.cc",
         "src/statement.cc",
         "src/helpers.cc",
-        "src/resultset.cc"
+        "src/resultset.cc",
+        "src/spill.cc",
+        "src/stats.cc"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")"
@@ -20,7 +22,8 @@
       "conditions": [
         ["OS=='linux'", {
           "libraries": [
-            "-lmimerapi"
+            "-lmimerapi",
+            "-ldl"
           ],
           "conditions": [
             ["target_arch=='arm64'", {
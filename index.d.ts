@@ -2,6 +2,8 @@
  * node-mimer - Node.js bindings for Mimer SQL
  */
 
+import { EventEmitter } from 'events';
+
 export interface ConnectOptions {
   /** Database name */
   dsn: string;
@@ -9,6 +11,122 @@ export interface ConnectOptions {
   user: string;
   /** Password */
   password: string;
+  /**
+   * Enable the client-side result cache (or share an existing one).
+   * Invalidation uses unqualified table names; reads through views are not
+   * invalidated by writes to their base tables.
+   */
+  cache?: boolean | ResultCacheOptions | ResultCache;
+  /** Default row limit for query() and execute() (0 = unlimited) */
+  maxRows?: number;
+  /** Default budget for row data in bytes (0 = unlimited) */
+  maxBytes?: number;
+  /** What to do when a limit is hit (default 'error') */
+  onLimit?: 'error' | 'truncate';
+  /** Time the phases of every statement (see QueryResult.timing) */
+  timing?: boolean;
+  /** Record every statement in the statement statistics table (default 5000 entries) */
+  statementStats?: boolean | { maxEntries?: number };
+  /** Report statements slower than a threshold */
+  slowQuery?: SlowQueryOptions | SlowQueryLog;
+}
+
+export interface SlowQueryOptions {
+  /** Report statements taking longer than this many milliseconds */
+  thresholdMs: number;
+  /** Receives each entry (default: one line with console.warn) */
+  sink?: (entry: SlowQueryEntry) => void;
+  /** Leave parameter values out of entries (default true) */
+  redact?: boolean;
+}
+
+export interface SlowQueryEntry {
+  operation: 'query' | 'execute' | 'cursor';
+  sql: string;
+  /** Normalized SQL, see fingerprint() */
+  fingerprint: string;
+  durationMs: number;
+  rowCount: number | null;
+  /** Native phase timing, when the statement reached the database */
+  timing: PhaseTiming | null;
+  /** Type per parameter; one array per parameter set for executeMany() */
+  paramTypes: Array<string | string[]>;
+  /** Only with redact: false */
+  params?: any[];
+  /** Error message when the statement failed */
+  error: string | null;
+  /** Calling stack, without the driver's frames */
+  stack: string;
+}
+
+export interface QueryOptions {
+  /** Stop after this many rows (0 = unlimited) */
+  maxRows?: number;
+  /** Stop when row data exceeds this many bytes (0 = unlimited) */
+  maxBytes?: number;
+  /** Throw (default) or return the rows so far with `truncated: true` */
+  onLimit?: 'error' | 'truncate';
+  /** Keep rows natively and spill past memoryBytes (default 64 MiB) to a temp file */
+  spill?: boolean | { memoryBytes?: number };
+  /** Share one JS string per repeated value: all character columns, or the named ones */
+  intern?: boolean | string[];
+  /** Distinct values per column before interning is abandoned (default 1024) */
+  internLimit?: number;
+  /** Return BINARY/VARBINARY values as Uint8Array views into shared ArrayBuffers */
+  binarySlab?: boolean;
+  /** Return CHAR/VARCHAR/NVARCHAR values as UTF-8 Buffers: all, or the named columns */
+  rawText?: boolean | string[];
+  /** Read only the start of BLOBs (bytes) and CLOBs/NCLOBs (chars); values become LobPreview */
+  lobPreview?: { bytes?: number; chars?: number };
+  /** Create each row with `new rowFactory()` and assign the columns to it */
+  rowFactory?: new () => any;
+  /** Property name to use for a column, keyed by column name */
+  fieldMap?: Record<string, string>;
+  /** Return rows as a Map keyed by this column's value */
+  keyBy?: string;
+  /** Group rows under their parent: one object per parentKey with childColumns in `as` */
+  nest?: NestOptions;
+  /** Time the phases of this statement, overriding the connection default */
+  timing?: boolean;
+}
+
+export interface NestOptions {
+  /** Column whose value identifies the parent row */
+  parentKey: string;
+  /** Columns that belong to the child objects */
+  childColumns: string[];
+  /** Property holding the child array (default 'children') */
+  as?: string;
+}
+
+export interface LobPreview<T = string | Buffer> {
+  /** The first bytes (BLOB) or characters (CLOB/NCLOB) */
+  preview: T;
+  /** Full length in bytes (BLOB) or characters (CLOB/NCLOB) */
+  totalSize: number;
+}
+
+export interface CursorOptions {
+  /** Return the same row object for every fetch, overwritten in place */
+  reuseRow?: boolean;
+}
+
+export interface ResultCacheOptions {
+  /** Approximate memory budget in bytes (default 32 MiB) */
+  maxBytes?: number;
+  /** Maximum number of cached results (default 10000) */
+  maxEntries?: number;
+  /** Entry lifetime in milliseconds, 0 = no expiry (default 60000) */
+  ttl?: number;
+}
+
+export interface CacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  invalidations: number;
+  entries: number;
+  bytes: number;
 }
 
 export interface PoolOptions extends ConnectOptions {
@@ -18,6 +136,13 @@ export interface PoolOptions extends ConnectOptions {
   idleTimeout?: number;
   /** Milliseconds to wait for a connection when pool is full (default 5000) */
   acquireTimeout?: number;
+  /** Share one execution among concurrent identical read-only queries */
+  singleFlight?: boolean | SingleFlightOptions;
+}
+
+export interface SingleFlightOptions {
+  /** Freeze shared results so callers cannot mutate each other's rows (default true) */
+  freeze?: boolean;
 }
 
 export interface FieldInfo {
@@ -31,13 +156,109 @@ export interface FieldInfo {
   nullable: boolean;
 }
 
+export interface PhaseTiming {
+  /** Milliseconds in MimerBeginStatement (0 for prepared statements) */
+  prepare: number;
+  /** Milliseconds binding parameters */
+  bind: number;
+  /** Milliseconds in MimerOpenCursor or MimerExecute */
+  execute: number;
+  /** Milliseconds in MimerFetch */
+  fetch: number;
+  /** Milliseconds building JS values (fields and rows) */
+  convert: number;
+  /** Sum of the phases */
+  total: number;
+  /** Rows converted */
+  rows: number;
+  /** Approximate bytes of row data converted */
+  bytes: number;
+}
+
+export interface TimingStats extends PhaseTiming {
+  /** Number of timed statements */
+  statements: number;
+}
+
+export interface DriverStats {
+  statementsPrepared: number;
+  statementsEnded: number;
+  cursorsOpened: number;
+  rowsFetched: number;
+  /** Decoded values by the JS type they become */
+  cells: {
+    null: number; integer: number; float: number; boolean: number;
+    string: number; binary: number; lob: number; other: number;
+  };
+  /** Bytes of strings, Buffers and LOB values produced */
+  bytes: { string: number; buffer: number; lob: number };
+  /** Bound parameters by JS type */
+  binds: {
+    null: number; boolean: number; integer: number; double: number;
+    string: number; buffer: number; lob: number; other: number;
+  };
+}
+
+export interface StatementStatsEntry {
+  /** Normalized SQL, see fingerprint() */
+  fingerprint: string;
+  calls: number;
+  /** Calls that threw */
+  errors: number;
+  /** Sum of rowCount (rows fetched, for cursors) */
+  rows: number;
+  /** Milliseconds */
+  totalTime: number;
+  meanTime: number;
+  maxTime: number;
+  /** Calls per latency bucket, bounds in statementLatencyBuckets plus one overflow bucket */
+  histogram: number[];
+}
+
+export interface StatementStatsOptions {
+  /** Entries to return (default 20, 0 = all) */
+  limit?: number;
+  /** Sort key, descending (default 'totalTime') */
+  orderBy?: 'totalTime' | 'meanTime' | 'maxTime' | 'calls' | 'rows';
+}
+
 export interface QueryResult {
-  /** Array of row objects (SELECT only) */
-  rows?: Record<string, any>[];
-  /** Number of rows returned or affected */
+  /** Array of row objects (SELECT only); SpilledRows with `spill`, a Map with `keyBy` */
+  rows?: Record<string, any>[] | SpilledRows | Map<any, Record<string, any>>;
+  /** Number of rows returned or affected (fetched rows, before keyBy/nest) */
   rowCount: number;
   /** Column metadata (SELECT only) */
   fields?: FieldInfo[];
+  /** Set when maxRows/maxBytes cut the result short with onLimit 'truncate' */
+  truncated?: boolean;
+  /** Phase timing, when the `timing` option is on */
+  timing?: PhaseTiming;
+}
+
+export interface ExecuteScriptOptions {
+  /** Throw on the first failing statement (default true) */
+  stopOnError?: boolean;
+  /** Run the script in one transaction, rolled back if it is aborted (DML only; DDL is rejected) */
+  transaction?: boolean;
+}
+
+export interface ScriptError extends Error {
+  mimerCode: number;
+  operation: string;
+  /** Position of the failing statement in the script */
+  statementIndex: number;
+  sql: string;
+}
+
+export interface ScriptResult {
+  /** Number of statements in the script */
+  statementCount: number;
+  /** Number of statements that succeeded */
+  executed: number;
+  /** Rows affected, summed over DML statements */
+  rowCount: number;
+  /** Failed statements (only with stopOnError: false) */
+  errors: ScriptError[];
 }
 
 export class MimerClient {
@@ -48,13 +269,13 @@ export class MimerClient {
   connect(options: ConnectOptions): Promise<void>;
 
   /** Execute a SQL statement with optional parameter binding */
-  query(sql: string, params?: any[]): Promise<QueryResult>;
+  query(sql: string, params?: any[], options?: QueryOptions): Promise<QueryResult>;
 
   /** Prepare a SQL statement for repeated execution */
   prepare(sql: string): Promise<PreparedStatement>;
 
   /** Execute a SELECT and return a cursor for row-at-a-time streaming */
-  queryCursor(sql: string, params?: any[]): Promise<ResultSet>;
+  queryCursor(sql: string, params?: any[], options?: CursorOptions): Promise<ResultSet>;
 
   /** Begin a new transaction */
   beginTransaction(): Promise<void>;
@@ -70,11 +291,62 @@ export class MimerClient {
 
   /** Check if connected to database */
   isConnected(): boolean;
+
+  /** Keep a reference table in memory, indexed by a key column */
+  replicate(source: string, options: ReplicateOptions): Promise<ReplicatedTable>;
+
+  /** Run a script of SQL statements in one native call */
+  executeScript(script: string | string[], options?: ExecuteScriptOptions): Promise<ScriptResult>;
+
+  /** Load keys into a work table, run fn(tableName), then drop the table */
+  withKeySet<T>(keys: any[], fn: (tableName: string) => Promise<T>, options?: KeySetOptions): Promise<T>;
+
+  /** Coalesce same-tick point lookups into one IN (...) query */
+  batchLoader(sqlTemplate: string, options?: BatchLoaderOptions): BatchLoader;
+
+  /** Poll a query and emit only the rows that changed */
+  watch(sql: string, params: any[], options: WatchOptions): QueryWatcher;
+
+  /** Drop cached results that read the given table */
+  invalidate(tag: string): number;
+
+  /** Result cache counters, or null when the cache is disabled */
+  cacheStats(): CacheStats | null;
+
+  /** Phase timing summed over the timed statements on this connection */
+  timingStats(reset?: boolean): TimingStats;
+
+  /** Native operation counters for this connection */
+  getStats(): DriverStats;
+}
+
+export interface ExecuteManyOptions {
+  /** SELECT only: return one flat `rows` array instead of `rowSets` */
+  flatten?: boolean;
+  /** Property holding the parameter set index in flattened rows (default '_set') */
+  setIndexColumn?: string;
+}
+
+export interface ExecuteManyResult {
+  rowCount: number;
+  /** SELECT only */
+  fields?: FieldInfo[];
+  /** SELECT only: one row array per parameter set */
+  rowSets?: any[][];
+  /** SELECT with flatten: all rows, tagged with their set index */
+  rows?: any[];
 }
 
 export class PreparedStatement {
   /** Execute the prepared statement with parameter values */
-  execute(params?: any[]): Promise<QueryResult>;
+  execute(params?: any[], options?: QueryOptions): Promise<QueryResult>;
+
+  /** Execute once per parameter set in a single native call */
+  executeMany(paramSets: any[][]): Promise<ExecuteManyResult>;
+  executeMany(paramSets: any[][], options: ExecuteManyOptions): Promise<ExecuteManyResult>;
+
+  /** Open a cursor on the prepared handle; closing it keeps the statement */
+  executeCursor(params?: any[], options?: CursorOptions): Promise<ResultSet>;
 
   /** Close the prepared statement and release resources */
   close(): Promise<void>;
@@ -108,28 +380,43 @@ export class Pool {
   readonly waitingCount: number;
 
   /** Acquire a connection, execute the query, and release */
-  query(sql: string, params?: any[]): Promise<QueryResult>;
+  query(sql: string, params?: any[], options?: QueryOptions): Promise<QueryResult>;
 
   /** Acquire a connection and open a cursor (auto-released on close) */
-  queryCursor(sql: string, params?: any[]): Promise<ResultSet>;
+  queryCursor(sql: string, params?: any[], options?: CursorOptions): Promise<ResultSet>;
 
   /** Check out a connection for multiple operations */
   connect(): Promise<PoolClient>;
 
+  /** Keep a reference table in memory, indexed by a key column */
+  replicate(source: string, options: ReplicateOptions): Promise<ReplicatedTable>;
+
+  /** Drop cached results that read the given table */
+  invalidate(tag: string): number;
+
+  /** Result cache counters, or null when the cache is disabled */
+  cacheStats(): CacheStats | null;
+
   /** Close all connections and shut down the pool */
   end(): Promise<void>;
 }
 
 export class PoolClient {
   /** Execute a SQL statement */
-  query(sql: string, params?: any[]): Promise<QueryResult>;
+  query(sql: string, params?: any[], options?: QueryOptions): Promise<QueryResult>;
 
   /** Open a cursor for row-at-a-time streaming */
-  queryCursor(sql: string, params?: any[]): Promise<ResultSet>;
+  queryCursor(sql: string, params?: any[], options?: CursorOptions): Promise<ResultSet>;
 
   /** Prepare a SQL statement */
   prepare(sql: string): Promise<PreparedStatement>;
 
+  /** Run a script of SQL statements in one native call */
+  executeScript(script: string | string[], options?: ExecuteScriptOptions): Promise<ScriptResult>;
+
+  /** Load keys into a work table, run fn(tableName), then drop the table */
+  withKeySet<T>(keys: any[], fn: (tableName: string) => Promise<T>, options?: KeySetOptions): Promise<T>;
+
   /** Begin a new transaction */
   beginTransaction(): Promise<void>;
 
@@ -139,15 +426,190 @@ export class PoolClient {
   /** Rollback the current transaction */
   rollback(): Promise<void>;
 
+  /** Phase timing summed over the timed statements on this connection */
+  timingStats(reset?: boolean): TimingStats;
+
+  /** Native operation counters for this connection */
+  getStats(): DriverStats;
+
   /** Return the connection to the pool */
   release(): void;
 }
 
+export interface ReplicateOptions {
+  /** Column to index rows by */
+  key: string;
+  /** Background refresh interval in milliseconds (default: no refresh) */
+  refreshMs?: number;
+  /** Monotonic version or timestamp column for incremental refresh */
+  versionColumn?: string;
+  /** Receives errors from background refreshes */
+  onError?: (err: Error) => void;
+}
+
+export class ReplicatedTable {
+  /** Number of replicated rows */
+  readonly size: number;
+
+  /** Time of the last completed refresh */
+  readonly lastRefresh: Date | null;
+
+  /** Look up a row by key (frozen, shared between callers) */
+  get(key: any): Record<string, any> | undefined;
+
+  /** Whether a row with this key exists */
+  has(key: any): boolean;
+
+  /** Iterate over the rows */
+  values(): IterableIterator<Record<string, any>>;
+
+  /** Iterate over the keys */
+  keys(): IterableIterator<any>;
+
+  /** Refresh now; `full` reloads everything and drops deleted rows */
+  refresh(options?: { full?: boolean }): Promise<void>;
+
+  /** Stop background refreshes */
+  close(): void;
+}
+
+export interface KeySetOptions {
+  /** SQL type of the key_value column (default: inferred from the keys) */
+  type?: string;
+}
+
+export interface BatchLoaderOptions {
+  /** Maximum keys per query (default 100) */
+  maxBatch?: number;
+  /** Result column holding the key (default: the column before IN (?)) */
+  key?: string;
+  /** Resolve each key to an array of rows instead of a single row */
+  many?: boolean;
+}
+
+export class BatchLoader {
+  /** Load the row for one key (null, or [] with `many`, when not found) */
+  load(key: any): Promise<any>;
+
+  /** Load several keys, in order */
+  loadMany(keys: any[]): Promise<any[]>;
+
+  /** Close the loader's prepared statements */
+  close(): Promise<void>;
+}
+
+export interface WatchOptions {
+  /** Column that uniquely identifies a row */
+  key: string;
+  /** Delay between polls in milliseconds (default 1000, 0 = manual poll()) */
+  intervalMs?: number;
+}
+
+export interface RowDiff {
+  inserted: any[];
+  updated: any[];
+  /** Key values of rows that are no longer present */
+  deleted: any[];
+  rowCount: number;
+}
+
+export class QueryWatcher extends EventEmitter {
+  /** Run one poll now; emits 'change' if anything changed */
+  poll(): Promise<RowDiff>;
+
+  /** Stop polling and release the prepared statement */
+  close(): void;
+
+  on(event: 'change', listener: (diff: RowDiff) => void): this;
+  on(event: 'error', listener: (err: Error) => void): this;
+}
+
+export class SpilledRows implements Iterable<Record<string, any>> {
+  /** Number of rows */
+  readonly length: number;
+  /** True if any rows were written to the temporary file */
+  readonly spilled: boolean;
+
+  /** Decode one row */
+  get(index: number): Record<string, any>;
+
+  [Symbol.iterator](): Iterator<Record<string, any>>;
+
+  /** Release the buffer and remove the temporary file */
+  close(): void;
+}
+
+export class SlowQueryLog {
+  constructor(options: SlowQueryOptions);
+  readonly thresholdMs: number;
+}
+
+export class ResultCache {
+  constructor(options?: ResultCacheOptions);
+
+  /** Look up a cached result */
+  get(sql: string, params?: any[]): QueryResult | undefined;
+
+  /** Store a SELECT result (frozen); returns the stored result */
+  set(sql: string, params: any[] | undefined, result: QueryResult): QueryResult;
+
+  /** Drop entries that read the given table */
+  invalidate(tag: string): number;
+
+  /** Invalidate the tables a write statement modifies */
+  invalidateStatement(sql: string): string[] | null;
+
+  /** Remove all entries */
+  clear(): void;
+
+  /** Hit/miss and occupancy counters */
+  stats(): CacheStats;
+}
+
 /** Create and connect a new MimerClient */
 export function connect(options: ConnectOptions): Promise<MimerClient>;
 
 /** Create a new connection pool */
 export function createPool(options: PoolOptions): Pool;
 
+/** Hash a parameter array natively (16-character hex string) */
+export function hashParams(params: any[]): string;
+
+/** Native operation counters summed over every connection in the process */
+export function getStats(): DriverStats;
+
+/** Top entries of the process-wide statement statistics table */
+export function getStatementStats(options?: StatementStatsOptions): StatementStatsEntry[];
+
+/** Clear the statement statistics table */
+export function resetStatementStats(): void;
+
+/** Upper bounds (ms) of the statement latency histogram buckets */
+export const statementLatencyBuckets: number[];
+
+/** Normalize SQL with literals replaced by ? (the fingerprint used in traces) */
+export function fingerprint(sql: string): string;
+
+/**
+ * Context object published on the `mimer:<operation>` tracing channels
+ * (connect, query, prepare, execute, fetch, commit, rollback, acquire).
+ */
+export interface TraceContext {
+  /** SQL text (query, prepare, execute, fetch) */
+  sql?: string | null;
+  /** Normalized SQL, see fingerprint() */
+  fingerprint?: string | null;
+  /** Rows returned or affected, set before the end events */
+  rowCount?: number;
+  /** Native phase timing, when the `timing` option is on */
+  timing?: PhaseTiming;
+  /** Set when the result came from the result cache */
+  cached?: boolean;
+  /** Set by the error event */
+  error?: Error;
+  /** Set by the end events */
+  result?: any;
+}
+
 /** Native addon version string */
 export const version: string;
@@ -31,6 +31,13 @@ const { MimerClient, connect } = require('./lib/client');
 const { PreparedStatement } = require('./lib/prepared');
 const { ResultSet } = require('./lib/resultset');
 const { Pool, PoolClient } = require('./lib/pool');
+const { ResultCache } = require('./lib/cache');
+const { ReplicatedTable } = require('./lib/replica');
+const { BatchLoader } = require('./lib/batchloader');
+const { QueryWatcher } = require('./lib/watch');
+const { SpilledRows } = require('./lib/spilled');
+const { SlowQueryLog } = require('./lib/slowlog');
+const { fingerprint } = require('./lib/tracing');
 
 function createPool(options) {
   return new Pool(options);
@@ -42,7 +49,19 @@ module.exports = {
   ResultSet,
   Pool,
   PoolClient,
+  ResultCache,
+  ReplicatedTable,
+  BatchLoader,
+  QueryWatcher,
+  SpilledRows,
+  SlowQueryLog,
   connect,
   createPool,
+  fingerprint,
+  hashParams: mimer.hashParams,
+  getStats: mimer.getStats,
+  getStatementStats: mimer.getStatementStats,
+  resetStatementStats: mimer.resetStatementStats,
+  statementLatencyBuckets: mimer.statementLatencyBuckets,
   version: mimer.version,
 };
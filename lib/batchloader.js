@@ -0,0 +1,226 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+// The column must start a word and must not be NOT: `x NOT IN (?)` is rejected
+const IN_PLACEHOLDER_RE = /(?<![A-Za-z0-9_$#])(?:([A-Za-z_][A-Za-z0-9_$#]*)\s*\.\s*)?(?!NOT\b)([A-Za-z_][A-Za-z0-9_$#]*)\s+IN\s*\(\s*\?\s*\)/i;
+
+/**
+ * Map a key to the form used to match rows back to callers. The database
+ * converts bound keys to the column type, so 7 and '7' both match a row
+ * whose key column reads back as 7; buffers compare by content.
+ */
+function keyOf(value) {
+  if (Buffer.isBuffer(value)) {
+    return 'b:' + value.toString('hex');
+  }
+  return 's:' + String(value);
+}
+
+/**
+ * Placeholder counts used for batches: powers of four up to maxBatch, plus
+ * maxBatch itself. A batch of n keys uses the smallest bucket >= n and pads
+ * the IN list by repeating its last key, so at most a handful of distinct
+ * statements are ever prepared.
+ */
+function bucketSizes(maxBatch) {
+  const sizes = [];
+  for (let n = 1; n < maxBatch; n *= 4) {
+    sizes.push(n);
+  }
+  sizes.push(maxBatch);
+  return sizes;
+}
+
+/**
+ * Run fn after the current tick, once already-resolved promise callbacks
+ * have had a chance to enqueue more keys.
+ */
+function enqueuePostPromiseJob(fn) {
+  Promise.resolve().then(() => process.nextTick(fn));
+}
+
+/**
+ * BatchLoader coalesces point lookups issued in the same tick into one
+ * `... WHERE key IN (?, ?, ...)` query and scatters the rows back to each
+ * caller by key.
+ */
+class BatchLoader {
+  /**
+   * @param {MimerClient} client
+   * @param {string} sqlTemplate - Query with a single `column IN (?)` placeholder
+   * @param {Object} [options]
+   * @param {number} [options.maxBatch] - Keys per query (default 100)
+   * @param {string} [options.key] - Result column holding the key
+   *   (default: the column in front of `IN (?)`)
+   * @param {boolean} [options.many] - Resolve each key to an array of rows
+   */
+  constructor(client, sqlTemplate, options = {}) {
+    const match = IN_PLACEHOLDER_RE.exec(sqlTemplate);
+    if (!match || sqlTemplate.split('?').length !== 2) {
+      throw new Error('batchLoader() template must contain exactly one "column IN (?)" placeholder');
+    }
+
+    this._client = client;
+    this._maxBatch = options.maxBatch > 0 ? Math.floor(options.maxBatch) : 100;
+    this._key = options.key || match[2];
+    this._many = !!options.many;
+
+    // Split around the "?" so the IN list can be expanded per bucket size
+    const open = match.index + match[0].lastIndexOf('(');
+    const close = match.index + match[0].length - 1;
+    this._prefix = sqlTemplate.slice(0, open + 1);
+    this._suffix = sqlTemplate.slice(close);
+    this._buckets = bucketSizes(this._maxBatch);
+
+    this._statements = new Map();  // bucket size → Promise<PreparedStatement>
+    this._queue = new Map();       // keyOf(key) → { key, waiters: [{ resolve, reject }] }
+    this._scheduled = false;
+    this._closed = false;
+  }
+
+  /**
+   * Load the row (or rows, with `many`) for one key.
+   * Resolves to null (or []) when no row matches.
+   * @param {*} key
+   * @returns {Promise<Object|null|Object[]>}
+   */
+  load(key) {
+    if (this._closed) {
+      return Promise.reject(new Error('Batch loader is closed'));
+    }
+
+    return new Promise((resolve, reject) => {
+      const k = keyOf(key);
+      let entry = this._queue.get(k);
+      if (entry === undefined) {
+        entry = { key, waiters: [] };
+        this._queue.set(k, entry);
+      }
+      entry.waiters.push({ resolve, reject });
+
+      if (!this._scheduled) {
+        this._scheduled = true;
+        enqueuePostPromiseJob(() => this._dispatch());
+      }
+    });
+  }
+
+  /**
+   * Load several keys; resolves in the same order as `keys`.
+   * @param {Array} keys
+   * @returns {Promise<Array>}
+   */
+  loadMany(keys) {
+    return Promise.all(keys.map((key) => this.load(key)));
+  }
+
+  _dispatch() {
+    this._scheduled = false;
+    const queue = this._queue;
+    this._queue = new Map();
+
+    const entries = [...queue.values()];
+    for (let i = 0; i < entries.length; i += this._maxBatch) {
+      const chunk = entries.slice(i, i + this._maxBatch);
+      this._runBatch(chunk).catch((err) => {
+        for (const entry of chunk) {
+          for (const waiter of entry.waiters) {
+            waiter.reject(err);
+          }
+        }
+      });
+    }
+  }
+
+  _statementFor(size) {
+    let stmt = this._statements.get(size);
+    if (stmt === undefined) {
+      const placeholders = new Array(size).fill('?').join(', ');
+      stmt = this._client.prepare(this._prefix + placeholders + this._suffix);
+      this._statements.set(size, stmt);
+      // Do not keep a failed prepare cached
+      stmt.catch(() => {
+        if (this._statements.get(size) === stmt) {
+          this._statements.delete(size);
+        }
+      });
+    }
+    return stmt;
+  }
+
+  async _runBatch(entries) {
+    const size = this._buckets.find((n) => n >= entries.length);
+    const params = entries.map((entry) => entry.key);
+    while (params.length < size) {
+      params.push(params[entries.length - 1]);
+    }
+
+    const stmt = await this._statementFor(size);
+    const result = await stmt.execute(params);
+
+    const keyColumn = this._key;
+    const found = new Map();
+    for (const row of result.rows) {
+      const k = keyOf(row[keyColumn]);
+      if (this._many) {
+        let list = found.get(k);
+        if (list === undefined) {
+          list = [];
+          found.set(k, list);
+        }
+        list.push(row);
+      } else if (!found.has(k)) {
+        found.set(k, row);
+      }
+    }
+
+    for (const entry of entries) {
+      const k = keyOf(entry.key);
+      const value = found.has(k) ? found.get(k) : (this._many ? [] : null);
+      for (const waiter of entry.waiters) {
+        waiter.resolve(value);
+      }
+    }
+  }
+
+  /**
+   * Close the prepared statements held by this loader.
+   * @returns {Promise<void>}
+   */
+  async close() {
+    this._closed = true;
+    const statements = [...this._statements.values()];
+    this._statements.clear();
+    for (const pending of statements) {
+      try {
+        const stmt = await pending;
+        await stmt.close();
+      } catch (e) {
+        // Ignore — a failed prepare has nothing to close
+      }
+    }
+  }
+}
+
+module.exports = { BatchLoader };
@@ -0,0 +1,442 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const mimer = require('./native');
+const {
+  normalizeSql, isReadOnly, freezeResult, sameParams,
+} = require('./singleflight');
+
+const DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+const DEFAULT_MAX_ENTRIES = 10000;
+const DEFAULT_TTL = 60000;
+
+// Query options that change how rows are decoded or shaped. A result
+// produced with any of them is not what a plain query returns (and keyBy
+// Maps or nested rows would be mis-sized by estimateResultSize), so it is
+// never stored.
+const DECODE_OPTIONS = [
+  'lobPreview', 'rawText', 'binarySlab', 'intern', 'rowFactory', 'fieldMap', 'keyBy', 'nest',
+];
+
+// Rough per-value overheads used by estimateResultSize()
+const OBJECT_OVERHEAD = 32;
+const PROPERTY_OVERHEAD = 16;
+const BUFFER_OVERHEAD = 64;
+
+const TOKEN_RE = /'(?:[^']|'')*'|"((?:[^"]|"")*)"|--[^\n]*|\/\*[\s\S]*?\*\/|([A-Za-z_][A-Za-z0-9_$#]*)|(\S)/g;
+
+/**
+ * Split SQL into identifier and punctuation tokens, dropping string
+ * literals and comments. Unquoted identifiers are upper-cased; quoted
+ * identifiers keep their case, matching SQL identifier semantics.
+ */
+function tokenize(sql) {
+  const tokens = [];
+  let m;
+  TOKEN_RE.lastIndex = 0;
+  while ((m = TOKEN_RE.exec(sql)) !== null) {
+    if (m[1] !== undefined) {
+      tokens.push({ ident: true, value: m[1].replace(/""/g, '"') });
+    } else if (m[2] !== undefined) {
+      tokens.push({ ident: true, keyword: true, value: m[2].toUpperCase() });
+    } else if (m[3] !== undefined) {
+      tokens.push({ ident: false, value: m[3] });
+    }
+  }
+  return tokens;
+}
+
+// Keywords that end a FROM list rather than being a table alias
+const CLAUSE_KEYWORDS = new Set([
+  'WHERE', 'GROUP', 'ORDER', 'HAVING', 'UNION', 'EXCEPT', 'INTERSECT',
+  'JOIN', 'INNER', 'LEFT', 'RIGHT', 'FULL', 'CROSS', 'NATURAL', 'ON',
+  'USING', 'FETCH', 'OFFSET', 'FOR', 'SET', 'VALUES', 'SELECT',
+]);
+
+/**
+ * Read a possibly schema-qualified table name at tokens[i].
+ * Returns { tag, next } where tag is the unqualified table name.
+ */
+function readTableName(tokens, i) {
+  const t = tokens[i];
+  if (!t || !t.ident) {
+    return null;
+  }
+  let tag = t.value;
+  let next = i + 1;
+  while (tokens[next] && tokens[next].value === '.'
+         && tokens[next + 1] && tokens[next + 1].ident) {
+    tag = tokens[next + 1].value;
+    next += 2;
+  }
+  return { tag, next };
+}
+
+/**
+ * Tables read by a query: every name following FROM or JOIN, including
+ * comma-separated FROM lists. Subqueries are covered by their own FROM.
+ * @param {string} sql
+ * @returns {string[]}
+ */
+function readTables(sql) {
+  const tokens = tokenize(sql);
+  const tags = new Set();
+
+  for (let i = 0; i < tokens.length; i++) {
+    const t = tokens[i];
+    if (!t.keyword || (t.value !== 'FROM' && t.value !== 'JOIN')) {
+      continue;
+    }
+    let j = i + 1;
+    for (;;) {
+      const name = readTableName(tokens, j);
+      if (!name) {
+        break;
+      }
+      tags.add(name.tag);
+      j = name.next;
+      // Skip an optional alias: [AS] alias
+      if (tokens[j] && tokens[j].keyword && tokens[j].value === 'AS') {
+        j++;
+      }
+      if (tokens[j] && tokens[j].ident && !CLAUSE_KEYWORDS.has(tokens[j].value)) {
+        j++;
+      }
+      if (!tokens[j] || tokens[j].value !== ',') {
+        break;
+      }
+      j++;
+    }
+  }
+  return [...tags];
+}
+
+/**
+ * Tables modified by a write statement, or null when the target cannot be
+ * determined (e.g. CALL), in which case callers should invalidate all.
+ * @param {string} sql
+ * @returns {string[]|null}
+ */
+function writeTables(sql) {
+  const tokens = tokenize(sql);
+  const first = tokens[0] && tokens[0].value;
+  let start = -1;
+
+  if (first === 'INSERT' || first === 'MERGE') {
+    start = tokens.findIndex((t) => t.keyword && t.value === 'INTO') + 1;
+  } else if (first === 'UPDATE') {
+    start = 1;
+  } else if (first === 'DELETE') {
+    start = tokens.findIndex((t) => t.keyword && t.value === 'FROM') + 1;
+  } else if (first === 'DROP' || first === 'ALTER' || first === 'TRUNCATE') {
+    if (tokens[1] && tokens[1].value === 'TABLE') {
+      start = 2;
+    } else if (tokens[1] && tokens[1].value === 'VIEW') {
+      return null;  // views are not tracked; drop everything
+    } else {
+      return [];    // DROP INDEX, ALTER SEQUENCE etc. do not change rows
+    }
+  } else if (first === 'CREATE' || first === 'GRANT' || first === 'REVOKE'
+             || first === 'COMMENT') {
+    return [];
+  }
+
+  if (start <= 0) {
+    return null;
+  }
+  const name = readTableName(tokens, start);
+  return name ? [name.tag] : null;
+}
+
+/**
+ * Normalize a user-supplied tag the same way table names are extracted.
+ */
+function normalizeTag(tag) {
+  const tokens = tokenize(tag);
+  const name = readTableName(tokens, 0);
+  return name ? name.tag : String(tag);
+}
+
+/**
+ * Whether a result produced with these per-call options may be cached.
+ * @param {Object} [options]
+ * @returns {boolean}
+ */
+function isCacheable(options) {
+  if (options === undefined || options === null) {
+    return true;
+  }
+  for (const name of DECODE_OPTIONS) {
+    if (options[name] !== undefined && options[name] !== false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Approximate heap footprint of a query result, in bytes.
+ */
+function estimateResultSize(result) {
+  let size = OBJECT_OVERHEAD;
+  const rows = result.rows || [];
+  for (const row of rows) {
+    size += OBJECT_OVERHEAD;
+    for (const key in row) {
+      const v = row[key];
+      size += PROPERTY_OVERHEAD;
+      if (typeof v === 'string') {
+        size += v.length * 2;
+      } else if (v !== null && typeof v === 'object' && v.byteLength !== undefined) {
+        size += v.byteLength + BUFFER_OVERHEAD;
+      } else {
+        size += 8;
+      }
+    }
+  }
+  if (result.fields) {
+    size += result.fields.length * (OBJECT_OVERHEAD + 4 * PROPERTY_OVERHEAD);
+  }
+  return size;
+}
+
+/**
+ * ResultCache is a bounded, in-process cache of SELECT results.
+ *
+ * Entries are keyed on normalized SQL plus a native hash of the parameters,
+ * expire after `ttl` milliseconds and are evicted least-recently-used first
+ * when `maxBytes` or `maxEntries` is exceeded. Each entry is tagged with the
+ * tables its query reads, so writes to a table invalidate dependent entries.
+ * Tags are unqualified names taken from the SQL text: a write to s1.t also
+ * drops reads of s2.t, and a query over a view is tagged with the view
+ * only, so writes to its base tables do not invalidate it.
+ *
+ * Cached results are frozen because every hit returns the same object.
+ */
+class ResultCache {
+  /**
+   * @param {Object} [options]
+   * @param {number} [options.maxBytes] - Memory budget (default 32 MiB)
+   * @param {number} [options.maxEntries] - Entry limit (default 10000)
+   * @param {number} [options.ttl] - Entry lifetime in ms, 0 = no expiry (default 60000)
+   */
+  constructor(options = {}) {
+    this._maxBytes = options.maxBytes !== undefined ? options.maxBytes : DEFAULT_MAX_BYTES;
+    this._maxEntries = options.maxEntries !== undefined ? options.maxEntries : DEFAULT_MAX_ENTRIES;
+    this._ttl = options.ttl !== undefined ? options.ttl : DEFAULT_TTL;
+
+    this._entries = new Map();  // key → entry, in LRU order (oldest first)
+    this._tags = new Map();     // tag → Set<key>
+    this._bytes = 0;
+
+    this._hits = 0;
+    this._misses = 0;
+    this._evictions = 0;
+    this._invalidations = 0;
+  }
+
+  _key(sql, params) {
+    return normalizeSql(sql) + '\u0000' + mimer.hashParams(params || []);
+  }
+
+  /**
+   * Look up a cached result.
+   * @param {string} sql
+   * @param {Array} params
+   * @returns {Object|undefined}
+   */
+  get(sql, params) {
+    const key = this._key(sql, params);
+    const entry = this._entries.get(key);
+
+    if (entry === undefined || !sameParams(entry.params, params || [])) {
+      this._misses++;
+      return undefined;
+    }
+    if (entry.expires !== 0 && entry.expires <= Date.now()) {
+      this._delete(key, entry);
+      this._misses++;
+      return undefined;
+    }
+
+    // Move to the most-recently-used end
+    this._entries.delete(key);
+    this._entries.set(key, entry);
+    this._hits++;
+    return entry.result;
+  }
+
+  /**
+   * Store a SELECT result. Results larger than the budget are not cached.
+   * @param {string} sql
+   * @param {Array} params
+   * @param {Object} result
+   * @returns {Object} the (now frozen) result
+   */
+  set(sql, params, result) {
+    if (!result || !result.rows) {
+      return result;
+    }
+    const size = estimateResultSize(result);
+    if (size > this._maxBytes) {
+      return result;
+    }
+
+    const key = this._key(sql, params);
+    const previous = this._entries.get(key);
+    if (previous !== undefined) {
+      this._delete(key, previous);
+    }
+
+    const entry = {
+      params: (params || []).slice(),
+      result: freezeResult(result),
+      size,
+      tags: readTables(sql),
+      expires: this._ttl > 0 ? Date.now() + this._ttl : 0,
+    };
+    this._entries.set(key, entry);
+    this._bytes += size;
+    for (const tag of entry.tags) {
+      let keys = this._tags.get(tag);
+      if (keys === undefined) {
+        keys = new Set();
+        this._tags.set(tag, keys);
+      }
+      keys.add(key);
+    }
+
+    this._evict();
+    return entry.result;
+  }
+
+  _evict() {
+    while (this._entries.size > 0
+           && (this._bytes > this._maxBytes || this._entries.size > this._maxEntries)) {
+      const [key, entry] = this._entries.entries().next().value;
+      this._delete(key, entry);
+      this._evictions++;
+    }
+  }
+
+  _delete(key, entry) {
+    this._entries.delete(key);
+    this._bytes -= entry.size;
+    for (const tag of entry.tags) {
+      const keys = this._tags.get(tag);
+      if (keys !== undefined) {
+        keys.delete(key);
+        if (keys.size === 0) {
+          this._tags.delete(tag);
+        }
+      }
+    }
+  }
+
+  /**
+   * Drop every entry that reads the given table.
+   * @param {string} tag - Table name (optionally schema-qualified)
+   * @returns {number} number of entries removed
+   */
+  invalidate(tag) {
+    const keys = this._tags.get(normalizeTag(tag));
+    if (keys === undefined) {
+      return 0;
+    }
+    let removed = 0;
+    for (const key of [...keys]) {
+      const entry = this._entries.get(key);
+      if (entry !== undefined) {
+        this._delete(key, entry);
+        removed++;
+      }
+    }
+    this._invalidations += removed;
+    return removed;
+  }
+
+  /**
+   * Invalidate whatever a write statement may have changed. Statements whose
+   * target cannot be determined clear the whole cache.
+   * @param {string} sql
+   * @returns {string[]|null} the invalidated tags, or null if cleared
+   */
+  invalidateStatement(sql) {
+    const tags = writeTables(sql);
+    if (tags === null) {
+      this.clear();
+      return null;
+    }
+    for (const tag of tags) {
+      this.invalidate(tag);
+    }
+    return tags;
+  }
+
+  /** Remove all entries. */
+  clear() {
+    this._invalidations += this._entries.size;
+    this._entries.clear();
+    this._tags.clear();
+    this._bytes = 0;
+  }
+
+  /**
+   * Hit/miss and occupancy counters.
+   * @returns {Object}
+   */
+  stats() {
+    return {
+      hits: this._hits,
+      misses: this._misses,
+      evictions: this._evictions,
+      invalidations: this._invalidations,
+      entries: this._entries.size,
+      bytes: this._bytes,
+    };
+  }
+}
+
+/**
+ * Build a ResultCache from a `cache` option: true, an options object, or an
+ * existing ResultCache (shared, e.g. by a Pool). Returns null when disabled.
+ */
+function createCache(option) {
+  if (!option) {
+    return null;
+  }
+  if (option instanceof ResultCache) {
+    return option;
+  }
+  return new ResultCache(typeof option === 'object' ? option : {});
+}
+
+module.exports = {
+  ResultCache,
+  createCache,
+  readTables,
+  writeTables,
+  isReadOnly,
+  isCacheable,
+};
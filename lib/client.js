@@ -23,6 +23,16 @@
 const mimer = require('./native');
 const { PreparedStatement } = require('./prepared');
 const { ResultSet } = require('./resultset');
+const { createCache, isReadOnly, isCacheable } = require('./cache');
+const { replicate } = require('./replica');
+const { BatchLoader } = require('./batchloader');
+const { withKeySet } = require('./keyset');
+const { QueryWatcher } = require('./watch');
+const { wrapSpilled } = require('./spilled');
+const {
+  channels, trace, sqlContext, elapsedMs, recordStatement, measured,
+} = require('./tracing');
+const { createSlowQueryLog, watchSlow, hideTiming } = require('./slowlog');
 
 /**
  * MimerClient provides a Promise-based interface to Mimer SQL
@@ -31,6 +41,12 @@ class MimerClient {
   constructor() {
     this.connection = new mimer.Connection();
     this.connected = false;
+    this._cache = null;
+    this._inTransaction = false;
+    this._txTags = null;  // tables written in the open transaction, null = all
+    this._statementStats = false;
+    this._slowLog = null;
+    this._hideTiming = false;  // timing is on only for the slow query log
   }
 
   /**
@@ -39,20 +55,51 @@ class MimerClient {
    * @param {string} options.dsn - Database name
    * @param {string} options.user - Username
    * @param {string} options.password - Password
+   * @param {boolean|Object|ResultCache} [options.cache] - Enable the result cache.
+   *   Invalidation uses unqualified table names from the SQL text; reads
+   *   through views are not invalidated by writes to their base tables.
+   * @param {number} [options.maxRows] - Default row limit for query()/execute()
+   * @param {number} [options.maxBytes] - Default byte budget for query()/execute()
+   * @param {string} [options.onLimit] - 'error' (default) or 'truncate'
+   * @param {boolean} [options.timing] - Time the phases of every statement
+   * @param {boolean|Object} [options.statementStats] - Record every statement
+   *   in the per-fingerprint statistics table; an object sets { maxEntries }
+   * @param {Object} [options.slowQuery] - { thresholdMs, sink, redact }:
+   *   report statements slower than thresholdMs
    * @returns {Promise<void>}
    */
   async connect(options) {
-    const { dsn, user, password } = options;
+    const {
+      dsn, user, password, cache, maxRows, maxBytes, onLimit, timing, statementStats,
+      slowQuery,
+    } = options;
 
     if (!dsn || !user || !password) {
       throw new Error('dsn, user, and password are required');
     }
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.connect, () => ({ dsn, user }), () => new Promise((resolve, reject) => {
       try {
+        const slowLog = createSlowQueryLog(slowQuery);
+        if (maxRows !== undefined || maxBytes !== undefined || onLimit !== undefined) {
+          this.connection.setFetchLimits({ maxRows, maxBytes, onLimit });
+        }
+        // The slow query log reports phase timings, so it needs them measured
+        if (timing || slowLog !== null) {
+          this.connection.setTiming(true);
+        }
+        if (statementStats) {
+          if (typeof statementStats === 'object') {
+            mimer.configureStatementStats(statementStats);
+          }
+          this._statementStats = true;
+        }
         const result = this.connection.connect(dsn, user, password);
         if (result) {
           this.connected = true;
+          this._cache = createCache(cache);
+          this._slowLog = slowLog;
+          this._hideTiming = slowLog !== null && !timing;
           resolve();
         } else {
           reject(new Error('Connection failed'));
@@ -60,30 +107,176 @@ class MimerClient {
       } catch (error) {
         reject(error);
       }
-    });
+    }));
   }
 
   /**
    * Execute a SQL query
    * @param {string} sql - SQL statement to execute
    * @param {Array} params - Optional parameters (for future prepared statement support)
+   * @param {Object} [options] - { maxRows, maxBytes, onLimit } for this call
    * @returns {Promise<Object>} Result object with rows and metadata
    */
-  async query(sql, params = []) {
+  async query(sql, params = [], options) {
+    if (!this.connected) {
+      throw new Error('Not connected to database');
+    }
+
+    const run = watchSlow(this._slowLog, 'query', sql, params, async (context) => {
+      // Per-call limits bypass the cache lookup: a cached result may be larger
+      if (this._cache !== null && !this._inTransaction && options === undefined
+          && isReadOnly(sql)) {
+        const cached = this._cache.get(sql, params);
+        if (cached !== undefined) {
+          if (context !== null) {
+            context.cached = true;
+          }
+          return cached;
+        }
+      }
+
+      return this._runQuery(sql, params, options);
+    });
+    return trace(channels.query, () => sqlContext(sql), measured(this._statementStats, sql, run));
+  }
+
+  /**
+   * Execute a statement without consulting the result cache (the result is
+   * still stored, and writes still invalidate). Used by Pool, which does its
+   * own lookup before acquiring a connection.
+   * @private
+   */
+  async _runQuery(sql, params = [], options) {
     if (!this.connected) {
       throw new Error('Not connected to database');
     }
 
     return new Promise((resolve, reject) => {
       try {
-        const result = this.connection.execute(sql, params);
-        resolve(result);
+        const result = wrapSpilled(this.connection.execute(sql, params, options));
+        if (this._hideTiming && !(options && options.timing)) {
+          hideTiming(result);
+        }
+        resolve(this._afterExecute(sql, params, result, options));
       } catch (error) {
         reject(error);
       }
     });
   }
 
+  /**
+   * Result-cache bookkeeping after a statement has run: SELECT results are
+   * stored (outside transactions, so uncommitted data is never cached) and
+   * writes invalidate the tables they touch. Tables written inside a
+   * transaction are invalidated again on commit, since other connections
+   * sharing the cache may have re-read the old rows in the meantime.
+   * Results decoded or shaped with per-call options such as lobPreview or
+   * keyBy are not stored, since a plain query for the same SQL must not get them.
+   * @private
+   */
+  _afterExecute(sql, params, result, options) {
+    const cache = this._cache;
+    if (cache === null) {
+      return result;
+    }
+
+    if (isReadOnly(sql)) {
+      const store = !this._inTransaction && !result.truncated && !result.spilled
+        && isCacheable(options);
+      return store ? cache.set(sql, params, result) : result;
+    }
+
+    const tags = cache.invalidateStatement(sql);
+    if (this._inTransaction && this._txTags !== null) {
+      if (tags === null) {
+        this._txTags = null;
+      } else {
+        for (const tag of tags) {
+          this._txTags.add(tag);
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Run a script of SQL statements in one native call.
+   * @param {string|string[]} script - Statements separated by `;`, or an array
+   * @param {Object} [options] - { stopOnError = true, transaction = false }.
+   *   transaction covers DML only: Mimer SQL commits DDL on its own, so a
+   *   script with DDL is rejected with a TypeError before anything runs.
+   * @returns {Promise<Object>} { statementCount, executed, rowCount, errors }
+   */
+  async executeScript(script, options = {}) {
+    if (!this.connected) {
+      throw new Error('Not connected to database');
+    }
+    if (options.transaction && this._inTransaction) {
+      throw new Error('executeScript() with transaction cannot run inside a transaction');
+    }
+
+    return new Promise((resolve, reject) => {
+      try {
+        resolve(this.connection.executeScript(script, options));
+      } catch (error) {
+        reject(error);
+      } finally {
+        // A script can write anything, even when it fails part way
+        this._invalidateAll();
+      }
+    });
+  }
+
+  /**
+   * Drop every cached result (inside a transaction, again on commit).
+   * @private
+   */
+  _invalidateAll() {
+    if (this._cache === null) {
+      return;
+    }
+    this._cache.clear();
+    if (this._inTransaction) {
+      this._txTags = null;
+    }
+  }
+
+  /**
+   * Invalidate cached results that read the given table.
+   * @param {string} tag - Table name
+   * @returns {number} Number of cache entries removed
+   */
+  invalidate(tag) {
+    return this._cache !== null ? this._cache.invalidate(tag) : 0;
+  }
+
+  /**
+   * Result cache counters, or null when the cache is disabled.
+   * @returns {Object|null} { hits, misses, evictions, invalidations, entries, bytes }
+   */
+  cacheStats() {
+    return this._cache !== null ? this._cache.stats() : null;
+  }
+
+  /**
+   * Phase timing summed over the timed statements on this connection.
+   * @param {boolean} [reset] - Clear the totals after reading them
+   * @returns {Object} { statements, prepare, bind, execute, fetch, convert,
+   *                     total, rows, bytes }
+   */
+  timingStats(reset = false) {
+    return this.connection.getTimingStats(reset);
+  }
+
+  /**
+   * Native operation counters for this connection: statements, cursors,
+   * rows, cells decoded per type, bytes produced and binds per type.
+   * @returns {Object}
+   */
+  getStats() {
+    return this.connection.getStats();
+  }
+
   /**
    * Begin a transaction
    * @returns {Promise<void>}
@@ -96,6 +289,8 @@ class MimerClient {
     return new Promise((resolve, reject) => {
       try {
         this.connection.beginTransaction();
+        this._inTransaction = true;
+        this._txTags = new Set();
         resolve();
       } catch (error) {
         reject(error);
@@ -112,14 +307,15 @@ class MimerClient {
       throw new Error('Not connected to database');
     }
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.commit, () => ({}), () => new Promise((resolve, reject) => {
       try {
         this.connection.commit();
+        this._endTransaction(true);
         resolve();
       } catch (error) {
         reject(error);
       }
-    });
+    }));
   }
 
   /**
@@ -131,14 +327,34 @@ class MimerClient {
       throw new Error('Not connected to database');
     }
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.rollback, () => ({}), () => new Promise((resolve, reject) => {
       try {
         this.connection.rollback();
+        this._endTransaction(false);
         resolve();
       } catch (error) {
         reject(error);
       }
-    });
+    }));
+  }
+
+  /**
+   * Leave transaction state; after a commit, re-invalidate the tables the
+   * transaction wrote.
+   * @private
+   */
+  _endTransaction(committed) {
+    if (committed && this._cache !== null && this._inTransaction) {
+      if (this._txTags === null) {
+        this._cache.clear();
+      } else {
+        for (const tag of this._txTags) {
+          this._cache.invalidate(tag);
+        }
+      }
+    }
+    this._inTransaction = false;
+    this._txTags = null;
   }
 
   /**
@@ -171,35 +387,96 @@ class MimerClient {
       throw new Error('Not connected to database');
     }
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.prepare, () => sqlContext(sql), () => new Promise((resolve, reject) => {
       try {
         const stmt = this.connection.prepare(sql);
-        resolve(new PreparedStatement(stmt));
+        resolve(new PreparedStatement(stmt, sql, this));
       } catch (error) {
         reject(error);
       }
-    });
+    }));
   }
 
   /**
    * Execute a SELECT query and return a cursor for row-at-a-time iteration.
    * @param {string} sql - SELECT statement (with optional ? placeholders)
    * @param {Array} params - Optional parameter values
+   * @param {Object} [options] - { reuseRow }
    * @returns {Promise<ResultSet>}
    */
-  async queryCursor(sql, params = []) {
+  async queryCursor(sql, params = [], options) {
     if (!this.connected) {
       throw new Error('Not connected to database');
     }
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.query, () => sqlContext(sql), watchSlow(this._slowLog, 'cursor', sql, params, () => new Promise((resolve, reject) => {
+      const start = this._statementStats ? process.hrtime.bigint() : 0n;
       try {
         const nativeRs = this.connection.executeQuery(sql, params);
-        resolve(new ResultSet(nativeRs));
+        const rs = new ResultSet(nativeRs, null, options, sql);
+        resolve(this._statementStats ? rs._recordStatement(elapsedMs(start)) : rs);
       } catch (error) {
+        if (this._statementStats) {
+          recordStatement(sql, elapsedMs(start), 0, true);
+        }
         reject(error);
       }
-    });
+    })));
+  }
+
+  /**
+   * Create a loader that coalesces point lookups made in the same tick into
+   * one IN (...) query.
+   * @param {string} sqlTemplate - Query with one `column IN (?)` placeholder
+   * @param {Object} [options] - { maxBatch, key, many }
+   * @returns {BatchLoader}
+   */
+  batchLoader(sqlTemplate, options) {
+    return new BatchLoader(this, sqlTemplate, options);
+  }
+
+  /**
+   * Load a large set of keys into a work table, call fn(tableName) so the
+   * caller can join against it, and drop the table afterwards.
+   * @param {Array} keys - Integers, strings or Buffers
+   * @param {Function} fn - async (tableName) => result
+   * @param {Object} [options] - { type } SQL type of the key_value column
+   * @returns {Promise<*>} the value returned by fn
+   */
+  async withKeySet(keys, fn, options) {
+    if (!this.connected) {
+      throw new Error('Not connected to database');
+    }
+    return withKeySet(this, keys, fn, options);
+  }
+
+  /**
+   * Keep a reference table (or query result) in memory, indexed by a key
+   * column, with optional background refresh.
+   * @param {string} source - Table name or SELECT statement
+   * @param {Object} options - { key, refreshMs, versionColumn, onError }
+   * @returns {Promise<ReplicatedTable>}
+   */
+  async replicate(source, options) {
+    if (!this.connected) {
+      throw new Error('Not connected to database');
+    }
+    return replicate(this, source, options);
+  }
+
+  /**
+   * Poll a query on an interval and emit only inserted, updated and deleted
+   * rows. Attach an 'error' listener; poll failures are emitted there.
+   * @param {string} sql - SELECT statement (with optional ? placeholders)
+   * @param {Array} params - Parameter values
+   * @param {Object} options - { key, intervalMs }
+   * @returns {QueryWatcher}
+   */
+  watch(sql, params = [], options = {}) {
+    if (!this.connected) {
+      throw new Error('Not connected to database');
+    }
+    return new QueryWatcher(this, sql, params, options);
   }
 
   /**
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const crypto = require('crypto');
+
+// Keys inserted per executeMany() call
+const LOAD_CHUNK = 10000;
+
+const INT32_MIN = -2147483648;
+const INT32_MAX = 2147483647;
+
+/**
+ * Pick a column type that can hold every key.
+ */
+function inferKeyType(keys) {
+  let ints = 0;
+  let small = true;
+  let strings = 0;
+  let buffers = 0;
+  let maxLength = 1;
+
+  for (const key of keys) {
+    if (typeof key === 'number' && Number.isSafeInteger(key)) {
+      ints++;
+      if (key < INT32_MIN || key > INT32_MAX) {
+        small = false;
+      }
+    } else if (typeof key === 'string') {
+      strings++;
+      maxLength = Math.max(maxLength, key.length);
+    } else if (Buffer.isBuffer(key)) {
+      buffers++;
+      maxLength = Math.max(maxLength, key.length);
+    } else {
+      throw new Error('withKeySet() keys must be integers, strings or Buffers');
+    }
+  }
+
+  if (ints === keys.length) {
+    return small ? 'INTEGER' : 'BIGINT';
+  }
+  if (strings === keys.length) {
+    return `NVARCHAR(${maxLength})`;
+  }
+  if (buffers === keys.length) {
+    return `VARBINARY(${maxLength})`;
+  }
+  throw new Error('withKeySet() keys must all have the same type');
+}
+
+/**
+ * Drop duplicate keys (Buffers compare by content) so the primary key on
+ * the work table cannot be violated.
+ */
+function uniqueKeys(keys) {
+  const seen = new Set();
+  const unique = [];
+  for (const key of keys) {
+    const id = Buffer.isBuffer(key) ? 'x:' + key.toString('hex') : key;
+    if (!seen.has(id)) {
+      seen.add(id);
+      unique.push(key);
+    }
+  }
+  return unique;
+}
+
+/**
+ * Load keys into a uniquely named work table with a single key_value
+ * column, run fn(tableName), and drop the table afterwards.
+ *
+ * The table is filled through PreparedStatement.executeMany(), which sends
+ * the keys in native batches rather than one round trip per key.
+ *
+ * @param {MimerClient} client
+ * @param {Array} keys - Integers, strings or Buffers (duplicates ignored)
+ * @param {Function} fn - async (tableName) => result
+ * @param {Object} [options]
+ * @param {string} [options.type] - SQL type of key_value (default: inferred)
+ * @returns {Promise<*>} whatever fn returns
+ */
+async function withKeySet(client, keys, fn, options = {}) {
+  if (client._inTransaction) {
+    // CREATE/DROP TABLE would commit the caller's transaction
+    throw new Error('withKeySet() cannot be used inside a transaction');
+  }
+
+  const unique = uniqueKeys(keys);
+  const type = options.type || inferKeyType(unique);
+  const tableName = 'KEYSET_' + crypto.randomBytes(8).toString('hex').toUpperCase();
+
+  await client.query(`CREATE TABLE ${tableName} (key_value ${type} PRIMARY KEY)`);
+  try {
+    if (unique.length > 0) {
+      const stmt = await client.prepare(`INSERT INTO ${tableName} (key_value) VALUES (?)`);
+      try {
+        for (let i = 0; i < unique.length; i += LOAD_CHUNK) {
+          const chunk = unique.slice(i, i + LOAD_CHUNK).map((key) => [key]);
+          await stmt.executeMany(chunk);
+        }
+      } finally {
+        await stmt.close();
+      }
+    }
+
+    return await fn(tableName);
+  } finally {
+    try {
+      await client.query(`DROP TABLE ${tableName}`);
+    } catch (e) {
+      // Ignore — the connection may already be closed
+    }
+  }
+}
+
+module.exports = { withKeySet };
@@ -22,6 +22,13 @@
 
 const { connect } = require('./client');
 const { ResultSet } = require('./resultset');
+const { SingleFlight } = require('./singleflight');
+const { createCache, isReadOnly } = require('./cache');
+const { replicate } = require('./replica');
+const {
+  channels, trace, sqlContext, elapsedMs, recordStatement, measured,
+} = require('./tracing');
+const { createSlowQueryLog, watchSlow } = require('./slowlog');
 
 /**
  * PoolClient wraps a MimerClient checked out from a Pool.
@@ -34,18 +41,34 @@ class PoolClient {
     this._released = false;
   }
 
-  async query(sql, params) {
-    return this._client.query(sql, params);
+  async query(sql, params, options) {
+    return this._client.query(sql, params, options);
   }
 
-  async queryCursor(sql, params) {
-    return this._client.queryCursor(sql, params);
+  async queryCursor(sql, params, options) {
+    return this._client.queryCursor(sql, params, options);
   }
 
   async prepare(sql) {
     return this._client.prepare(sql);
   }
 
+  async withKeySet(keys, fn, options) {
+    return this._client.withKeySet(keys, fn, options);
+  }
+
+  async executeScript(script, options) {
+    return this._client.executeScript(script, options);
+  }
+
+  timingStats(reset) {
+    return this._client.timingStats(reset);
+  }
+
+  getStats() {
+    return this._client.getStats();
+  }
+
   async beginTransaction() {
     return this._client.beginTransaction();
   }
@@ -72,7 +95,10 @@ class PoolClient {
  */
 class Pool {
   constructor(options) {
-    const { dsn, user, password, max, idleTimeout, acquireTimeout } = options;
+    const {
+      dsn, user, password, max, idleTimeout, acquireTimeout, singleFlight,
+      cache, maxRows, maxBytes, onLimit, timing, statementStats, slowQuery,
+    } = options;
     if (!dsn || !user || !password) {
       throw new Error('dsn, user, and password are required');
     }
@@ -82,12 +108,28 @@ class Pool {
     this._max = max || 10;
     this._idleTimeout = idleTimeout !== undefined ? idleTimeout : 30000;
     this._acquireTimeout = acquireTimeout !== undefined ? acquireTimeout : 5000;
+    this._limits = { maxRows, maxBytes, onLimit };
+    this._timing = timing;
+    this._statementStats = statementStats || false;
+    // One log shared by the pool and its connections
+    this._slowLog = createSlowQueryLog(slowQuery);
 
     this._pool = [];       // idle clients
     this._active = 0;      // checked-out count
     this._waiters = [];    // { resolve, reject, timer }
     this._closed = false;
     this._idleTimers = new Map();
+
+    // Opt-in deduplication of concurrent identical read-only queries
+    this._singleFlight = null;
+    if (singleFlight) {
+      this._singleFlight = new SingleFlight(
+        typeof singleFlight === 'object' ? singleFlight : {}
+      );
+    }
+
+    // Optional result cache, shared by every connection in the pool
+    this._cache = createCache(cache);
   }
 
   get totalCount() {
@@ -110,7 +152,16 @@ class Pool {
     if (this._closed) {
       throw new Error('Pool is closed');
     }
+    return trace(channels.acquire, () => ({
+      idleCount: this.idleCount, activeCount: this.activeCount,
+    }), () => this._checkOut());
+  }
 
+  /**
+   * Hand out an idle connection, open a new one, or wait for a release.
+   * @private
+   */
+  async _checkOut() {
     // 1. Reuse an idle connection
     if (this._pool.length > 0) {
       const client = this._pool.pop();
@@ -131,6 +182,11 @@ class Pool {
           dsn: this._dsn,
           user: this._user,
           password: this._password,
+          cache: this._cache,
+          timing: this._timing,
+          statementStats: this._statementStats,
+          slowQuery: this._slowLog || undefined,
+          ...this._limits,
         });
         return client;
       } catch (err) {
@@ -187,27 +243,87 @@ class Pool {
     }
   }
 
-  async query(sql, params) {
+  async query(sql, params, options) {
+    const run = watchSlow(this._slowLog, 'query', sql, params, async (context) => {
+      // Per-call limits skip sharing: another caller's result may be larger
+      if (options !== undefined) {
+        return this._query(sql, params, options);
+      }
+      if (this._cache !== null && isReadOnly(sql)) {
+        const cached = this._cache.get(sql, params);
+        if (cached !== undefined) {
+          if (context !== null) {
+            context.cached = true;
+          }
+          return cached;
+        }
+      }
+      if (this._singleFlight) {
+        return this._singleFlight.run(sql, params, () => this._query(sql, params));
+      }
+      return this._query(sql, params);
+    });
+    return trace(channels.query, () => sqlContext(sql),
+      measured(Boolean(this._statementStats), sql, run));
+  }
+
+  async _query(sql, params, options) {
     const client = await this._acquire();
     try {
-      return await client.query(sql, params);
+      return await client._runQuery(sql, params, options);
     } finally {
       this._release(client);
     }
   }
 
-  async queryCursor(sql, params) {
+  async queryCursor(sql, params, options) {
     const client = await this._acquire();
-    try {
-      const nativeRs = client.connection.executeQuery(sql, params || []);
-      const rs = new ResultSet(nativeRs, () => {
+    return trace(channels.query, () => sqlContext(sql), watchSlow(this._slowLog, 'cursor', sql, params, async () => {
+      const start = client._statementStats ? process.hrtime.bigint() : 0n;
+      try {
+        const nativeRs = client.connection.executeQuery(sql, params || []);
+        const rs = new ResultSet(nativeRs, () => {
+          this._release(client);
+        }, options, sql);
+        return client._statementStats ? rs._recordStatement(elapsedMs(start)) : rs;
+      } catch (err) {
+        if (client._statementStats) {
+          recordStatement(sql, elapsedMs(start), 0, true);
+        }
         this._release(client);
-      });
-      return rs;
-    } catch (err) {
-      this._release(client);
-      throw err;
+        throw err;
+      }
+    }));
+  }
+
+  /**
+   * Keep a reference table in memory; each refresh borrows a connection.
+   * @param {string} source - Table name or SELECT statement
+   * @param {Object} options - { key, refreshMs, versionColumn, onError }
+   * @returns {Promise<ReplicatedTable>}
+   */
+  async replicate(source, options) {
+    if (this._closed) {
+      throw new Error('Pool is closed');
     }
+    return replicate(this, source, options);
+  }
+
+  /**
+   * Invalidate cached results that read the given table.
+   * @param {string} tag - Table name
+   * @returns {number} Number of cache entries removed
+   */
+  invalidate(tag) {
+    return this._cache !== null ? this._cache.invalidate(tag) : 0;
+  }
+
+  /**
+   * Result cache counters, or null when the cache is disabled.
+   * @returns {Object|null}
+   */
+  cacheStats() {
+    return this._cache !== null ? this._cache.stats() : null;
   }
 
   async connect() {
@@ -20,33 +20,132 @@
 //
 // See license for more details.
 
+const { isReadOnly } = require('./cache');
+const { wrapSpilled } = require('./spilled');
+const { ResultSet } = require('./resultset');
+const {
+  channels, trace, sqlContext, elapsedMs, recordStatement, measured,
+} = require('./tracing');
+const { watchSlow, hideTiming } = require('./slowlog');
+
 /**
  * PreparedStatement wraps a native prepared statement for reuse
  */
 class PreparedStatement {
-  constructor(nativeStmt) {
+  /**
+   * @param {Object} nativeStmt - Native Statement handle
+   * @param {string} [sql] - The prepared SQL text
+   * @param {MimerClient} [client] - Owning client (result cache, transactions)
+   */
+  constructor(nativeStmt, sql, client) {
     this._stmt = nativeStmt;
     this._closed = false;
+    this._sql = sql || null;
+    this._client = client || null;
+    this._readOnly = this._sql !== null && isReadOnly(this._sql);
+    this._statementStats = this._client !== null && this._client._statementStats;
+    this._slowLog = this._client !== null ? this._client._slowLog : null;
+    this._hideTiming = this._client !== null && this._client._hideTiming;
   }
 
   /**
    * Execute the prepared statement with parameters
    * @param {Array} params - Parameter values for ? placeholders
+   * @param {Object} [options] - { maxRows, maxBytes, onLimit } for this call
    * @returns {Promise<Object>} Result object with rows and metadata
    */
-  async execute(params = []) {
+  async execute(params = [], options) {
     if (this._closed) {
       throw new Error('Statement is closed');
     }
 
-    return new Promise((resolve, reject) => {
+    const client = this._client;
+    const cache = client !== null ? client._cache : null;
+    const run = watchSlow(this._slowLog, 'execute', this._sql, params, (context) => {
+      if (cache !== null && this._readOnly && !client._inTransaction
+          && options === undefined) {
+        const cached = cache.get(this._sql, params);
+        if (cached !== undefined) {
+          if (context !== null) {
+            context.cached = true;
+          }
+          return Promise.resolve(cached);
+        }
+      }
+
+      return new Promise((resolve, reject) => {
+        try {
+          const result = wrapSpilled(this._stmt.execute(params, options));
+          if (this._hideTiming && !(options && options.timing)) {
+            hideTiming(result);
+          }
+          resolve(cache !== null
+            ? client._afterExecute(this._sql, params, result, options)
+            : result);
+        } catch (error) {
+          reject(error);
+        }
+      });
+    });
+    return trace(channels.execute, () => sqlContext(this._sql),
+      measured(this._statementStats, this._sql, run));
+  }
+
+  /**
+   * Execute the statement once per parameter set in a single native call.
+   * For a SELECT, returns { fields, rowSets, rowCount } with one row array
+   * per parameter set, or with `flatten` { fields, rows, rowCount } where
+   * each row carries its parameter set index in `setIndexColumn`.
+   * @param {Array<Array>} paramSets - One parameter array per execution
+   * @param {Object} [options] - { flatten, setIndexColumn } (SELECT only)
+   * @returns {Promise<Object>} { rowCount } summed over all executions
+   */
+  async executeMany(paramSets, options) {
+    if (this._closed) {
+      throw new Error('Statement is closed');
+    }
+
+    const client = this._client;
+    const run = watchSlow(this._slowLog, 'execute', this._sql, paramSets, () => new Promise((resolve, reject) => {
       try {
-        const result = this._stmt.execute(params);
-        resolve(result);
+        const result = this._stmt.executeMany(paramSets, options);
+        // Query batches are not cached; writes still invalidate
+        resolve(client !== null && client._cache !== null && !this._readOnly
+          ? client._afterExecute(this._sql, [], result)
+          : result);
       } catch (error) {
         reject(error);
       }
-    });
+    }));
+    return trace(channels.execute, () => sqlContext(this._sql),
+      measured(this._statementStats, this._sql, run));
+  }
+
+  /**
+   * Execute a prepared SELECT and return a cursor, reusing the prepared
+   * handle. Closing the cursor leaves the statement open for reuse; only
+   * one cursor can be open per statement at a time.
+   * @param {Array} params - Parameter values for ? placeholders
+   * @param {Object} [options] - { reuseRow }
+   * @returns {Promise<ResultSet>}
+   */
+  async executeCursor(params = [], options) {
+    if (this._closed) {
+      throw new Error('Statement is closed');
+    }
+
+    return trace(channels.execute, () => sqlContext(this._sql), watchSlow(this._slowLog, 'cursor', this._sql, params, () => new Promise((resolve, reject) => {
+      const start = this._statementStats ? process.hrtime.bigint() : 0n;
+      try {
+        const rs = new ResultSet(this._stmt.executeCursor(params), null, options, this._sql);
+        resolve(this._statementStats ? rs._recordStatement(elapsedMs(start)) : rs);
+      } catch (error) {
+        if (this._statementStats) {
+          recordStatement(this._sql, elapsedMs(start), 0, true);
+        }
+        reject(error);
+      }
+    })));
   }
 
   /**
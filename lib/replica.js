@@ -0,0 +1,199 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const IDENTIFIER_RE = /^[A-Za-z_][A-Za-z0-9_$#]*(?:\.[A-Za-z_][A-Za-z0-9_$#]*)?$/;
+
+/**
+ * ReplicatedTable keeps a small table (or query result) in memory, indexed
+ * by a key column, and refreshes it in the background.
+ *
+ * Rows are frozen when loaded and the index is a Map, so get(key) returns
+ * the stored row without a database round trip or any per-lookup
+ * allocation.
+ *
+ * With a `versionColumn`, refreshes only fetch rows whose version is at
+ * least the highest version seen so far and upsert them. Deleted rows are
+ * not detected incrementally; call refresh({ full: true }) to rebuild.
+ * Without a version column every refresh reloads the whole source.
+ */
+class ReplicatedTable {
+  /**
+   * @param {Object} executor - MimerClient or Pool (anything with queryCursor)
+   * @param {string} source - Table name or SELECT statement
+   * @param {Object} options
+   * @param {string} options.key - Column to index rows by
+   * @param {number} [options.refreshMs] - Background refresh interval (0 = off)
+   * @param {string} [options.versionColumn] - Monotonic version/timestamp column
+   * @param {Function} [options.onError] - Called with background refresh errors
+   */
+  constructor(executor, source, options = {}) {
+    if (!options.key) {
+      throw new Error('replicate() requires a key column');
+    }
+    this._executor = executor;
+    this._key = options.key;
+    this._versionColumn = options.versionColumn || null;
+    this._onError = options.onError || null;
+
+    const trimmed = source.trim();
+    this._baseSql = IDENTIFIER_RE.test(trimmed)
+      ? `SELECT * FROM ${trimmed}`
+      : trimmed;
+
+    this._rows = new Map();
+    this._version = null;
+    this._refreshing = null;
+    this._closed = false;
+    this.lastRefresh = null;
+
+    this._timer = null;
+    if (options.refreshMs > 0) {
+      this._timer = setInterval(() => {
+        this.refresh().catch((err) => {
+          if (this._onError) {
+            this._onError(err);
+          }
+        });
+      }, options.refreshMs);
+      this._timer.unref();
+    }
+  }
+
+  /** Number of replicated rows */
+  get size() {
+    return this._rows.size;
+  }
+
+  /**
+   * Look up a row by key. Returns the shared frozen row, or undefined.
+   * @param {*} key
+   * @returns {Object|undefined}
+   */
+  get(key) {
+    return this._rows.get(key);
+  }
+
+  /**
+   * @param {*} key
+   * @returns {boolean}
+   */
+  has(key) {
+    return this._rows.has(key);
+  }
+
+  /** Iterate over the replicated rows */
+  values() {
+    return this._rows.values();
+  }
+
+  /** Iterate over the keys */
+  keys() {
+    return this._rows.keys();
+  }
+
+  /**
+   * Refresh from the database. Concurrent calls share one refresh.
+   * @param {Object} [options]
+   * @param {boolean} [options.full] - Reload everything, dropping deleted rows
+   * @returns {Promise<void>}
+   */
+  refresh(options = {}) {
+    if (this._closed) {
+      return Promise.reject(new Error('Replicated table is closed'));
+    }
+    if (this._refreshing === null) {
+      const full = !!options.full || this._version === null;
+      this._refreshing = this._load(full).finally(() => {
+        this._refreshing = null;
+      });
+    }
+    return this._refreshing;
+  }
+
+  async _load(full) {
+    let sql = this._baseSql;
+    let params = [];
+    if (!full && this._versionColumn !== null) {
+      // >= so rows committed later with the boundary version are not missed
+      sql = `SELECT * FROM (${this._baseSql}) AS r WHERE r.${this._versionColumn} >= ?`;
+      params = [this._version];
+    }
+
+    const target = full ? new Map() : this._rows;
+    const key = this._key;
+    const versionColumn = this._versionColumn;
+    let version = full ? null : this._version;
+
+    const cursor = await this._executor.queryCursor(sql, params);
+    try {
+      for await (const row of cursor) {
+        target.set(row[key], Object.freeze(row));
+        if (versionColumn !== null) {
+          const v = row[versionColumn];
+          if (v !== null && (version === null || v > version)) {
+            version = v;
+          }
+        }
+      }
+    } finally {
+      await cursor.close();
+    }
+
+    if (this._closed) {
+      return;
+    }
+    this._rows = target;
+    this._version = versionColumn !== null ? version : null;
+    this.lastRefresh = new Date();
+  }
+
+  /**
+   * Stop background refreshes and release the replicated rows.
+   */
+  close() {
+    this._closed = true;
+    if (this._timer !== null) {
+      clearInterval(this._timer);
+      this._timer = null;
+    }
+    this._rows = new Map();
+  }
+}
+
+/**
+ * Create a ReplicatedTable and perform the initial load.
+ * @returns {Promise<ReplicatedTable>}
+ */
+async function replicate(executor, source, options) {
+  const table = new ReplicatedTable(executor, source, options);
+  try {
+    await table.refresh({ full: true });
+  } catch (err) {
+    table.close();
+    throw err;
+  }
+  return table;
+}
+
+module.exports = { ReplicatedTable, replicate };
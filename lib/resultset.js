@@ -20,17 +20,49 @@
 //
 // See license for more details.
 
+const { channels, trace, sqlContext, elapsedMs, recordStatement } = require('./tracing');
+
+// Rows read from the native cursor per call; next() hands them out one by one
+const FETCH_BATCH = 64;
+
 /**
  * ResultSet wraps a native cursor for row-at-a-time iteration.
  * Supports both manual next()/close() and async iteration (for-await-of).
+ * Rows are read from the native cursor FETCH_BATCH at a time, and each
+ * batch is one `mimer:fetch` event.
+ *
+ * With `reuseRow`, every fetch overwrites the same row object instead of
+ * allocating a new one, so rows are read one per call. Copy a row (e.g.
+ * `{ ...row }`) before keeping it past the next call to next().
  */
 class ResultSet {
-  constructor(nativeRs, onClose) {
+  constructor(nativeRs, onClose, options, sql) {
     this._rs = nativeRs;
+    this._sql = sql || null;
+    this._reuseRow = !!(options && options.reuseRow);
+    if (this._reuseRow) {
+      nativeRs.setReuseRow(true);
+    }
+    this._batch = [];      // fetched rows not yet returned by next()
+    this._batchPos = 0;
     this._fields = null;
     this._closed = false;
     this._onClose = onClose || null;
     this._onCloseCalled = false;
+    this._statementMs = -1;  // >= 0 while recording statement statistics
+    this._statementRows = 0;
+  }
+
+  /**
+   * Record this cursor in the statement statistics table when it closes:
+   * latency is `openMs` plus the time spent in fetches, not the time the
+   * caller holds it open.
+   * @param {number} openMs - Time taken to open the cursor
+   * @private
+   */
+  _recordStatement(openMs) {
+    this._statementMs = openMs;
+    return this;
   }
 
   _invokeOnClose() {
@@ -38,6 +70,10 @@ class ResultSet {
       this._onCloseCalled = true;
       this._onClose();
     }
+    if (this._statementMs >= 0) {
+      recordStatement(this._sql, this._statementMs, this._statementRows, false);
+      this._statementMs = -1;
+    }
   }
 
   /**
@@ -57,23 +93,52 @@ class ResultSet {
    * @returns {Promise<Object|null>}
    */
   async next() {
+    // Rows still buffered are dropped if the cursor was closed under us
+    // (connection or statement closed) rather than by reaching its end
+    if (this._batchPos < this._batch.length && (this._closed || !this._rs.isClosed())) {
+      const row = this._batch[this._batchPos];
+      this._batch[this._batchPos++] = undefined;
+      return row;
+    }
     if (this._closed) {
       return null;
     }
+    this._batch = [];
+    this._batchPos = 0;
 
-    return new Promise((resolve, reject) => {
+    return trace(channels.fetch, () => sqlContext(this._sql), (context) => new Promise((resolve, reject) => {
+      const start = this._statementMs >= 0 ? process.hrtime.bigint() : 0n;
       try {
-        const row = this._rs.fetchNext();
-        if (row === null) {
+        let rows;
+        let exhausted;
+        if (this._reuseRow) {
+          const row = this._rs.fetchNext();
+          rows = row === null ? [] : [row];
+          exhausted = row === null;
+        } else {
+          rows = this._rs.fetchBatch(FETCH_BATCH);
+          exhausted = rows.length < FETCH_BATCH;
+        }
+        if (this._statementMs >= 0) {
+          this._statementMs += elapsedMs(start);
+          this._statementRows += rows.length;
+        }
+        // The rows are already read, so the cursor can go before they are used
+        if (exhausted) {
           this._closed = true;
           this._rs.close();
           this._invokeOnClose();
         }
-        resolve(row);
+        if (context !== null) {
+          context.rowCount = rows.length;
+        }
+        this._batch = rows;
+        this._batchPos = rows.length > 0 ? 1 : 0;
+        resolve(rows.length > 0 ? rows[0] : null);
       } catch (error) {
         reject(error);
       }
-    });
+    }));
   }
 
   /**
@@ -81,6 +146,8 @@ class ResultSet {
    * @returns {Promise<void>}
    */
   async close() {
+    this._batch = [];
+    this._batchPos = 0;
     if (this._closed) {
       return;
     }
@@ -0,0 +1,181 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const mimer = require('./native');
+
+const READ_ONLY_RE = /^\s*(?:SELECT|WITH|VALUES)\b/i;
+
+/**
+ * Collapse runs of whitespace outside quoted literals and identifiers so
+ * that differently formatted copies of the same statement share a key.
+ * @param {string} sql
+ * @returns {string}
+ */
+function normalizeSql(sql) {
+  let out = '';
+  let quote = null;
+  let pendingSpace = false;
+
+  for (let i = 0; i < sql.length; i++) {
+    const ch = sql[i];
+    if (quote) {
+      out += ch;
+      if (ch === quote) {
+        quote = null;
+      }
+      continue;
+    }
+    if (ch === ' ' || ch === '\t' || ch === '\n' || ch === '\r') {
+      pendingSpace = out.length > 0;
+      continue;
+    }
+    if (pendingSpace) {
+      out += ' ';
+      pendingSpace = false;
+    }
+    if (ch === "'" || ch === '"') {
+      quote = ch;
+    }
+    out += ch;
+  }
+  return out;
+}
+
+/**
+ * Whether a statement only reads data and may safely share a result.
+ * @param {string} sql
+ * @returns {boolean}
+ */
+function isReadOnly(sql) {
+  return READ_ONLY_RE.test(sql);
+}
+
+function sameParams(a, b) {
+  if (a.length !== b.length) {
+    return false;
+  }
+  for (let i = 0; i < a.length; i++) {
+    const x = a[i];
+    const y = b[i];
+    if (x === y || (x == null && y == null)) {
+      continue;
+    }
+    if (Buffer.isBuffer(x) && Buffer.isBuffer(y) && x.equals(y)) {
+      continue;
+    }
+    if (Number.isNaN(x) && Number.isNaN(y)) {
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Freeze a query result (rows, fields and the result object itself) so it
+ * can be handed to several callers without one mutating another's view.
+ * @param {Object} result
+ * @returns {Object} the same result, frozen
+ */
+function freezeResult(result) {
+  if (result.rows) {
+    for (const row of result.rows) {
+      Object.freeze(row);
+    }
+    Object.freeze(result.rows);
+  }
+  if (result.fields) {
+    for (const field of result.fields) {
+      Object.freeze(field);
+    }
+    Object.freeze(result.fields);
+  }
+  return Object.freeze(result);
+}
+
+/**
+ * SingleFlight coalesces concurrent identical read-only queries.
+ * While a query is in flight, callers issuing the same statement with the
+ * same parameters join it and receive the same result object instead of
+ * running their own execution. Results are frozen unless `freeze` is
+ * false, so one caller cannot change the rows another sees.
+ */
+class SingleFlight {
+  /**
+   * @param {Object} [options]
+   * @param {boolean} [options.freeze=true] - Freeze shared results
+   */
+  constructor(options = {}) {
+    this._freeze = options.freeze !== false;
+    this._inflight = new Map();  // key → { params, promise }
+  }
+
+  /** Number of distinct executions currently in flight */
+  get size() {
+    return this._inflight.size;
+  }
+
+  /**
+   * Run execute() for (sql, params), or join an identical in-flight run.
+   * Statements that are not read-only always execute on their own.
+   * @param {string} sql
+   * @param {Array} params
+   * @param {Function} execute - () => Promise<Object>
+   * @returns {Promise<Object>}
+   */
+  run(sql, params, execute) {
+    if (typeof sql !== 'string' || !isReadOnly(sql)) {
+      return execute();
+    }
+
+    const values = Array.isArray(params) ? params : [];
+    const key = normalizeSql(sql) + '\u0000' + mimer.hashParams(values);
+
+    const entry = this._inflight.get(key);
+    if (entry) {
+      // Guard against hash collisions before sharing a result
+      if (sameParams(entry.params, values)) {
+        return entry.promise;
+      }
+      return execute();
+    }
+
+    const freeze = this._freeze;
+    const promise = execute().then((result) =>
+      freeze ? freezeResult(result) : result
+    );
+    this._inflight.set(key, { params: values.slice(), promise });
+
+    const done = () => {
+      this._inflight.delete(key);
+    };
+    promise.then(done, done);
+
+    return promise;
+  }
+}
+
+module.exports = {
+  SingleFlight, normalizeSql, isReadOnly, freezeResult, sameParams,
+};
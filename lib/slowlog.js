@@ -0,0 +1,180 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const path = require('node:path');
+const { fingerprint, elapsedMs } = require('./tracing');
+
+// Frames from the driver's own modules are left out of reported stacks
+const DRIVER_DIR = __dirname + path.sep;
+
+// Phase timings the log turned on, kept off results whose caller did not
+// ask for them
+const hiddenTimings = new WeakMap();
+
+/**
+ * Move `result.timing` out of a result, where only the log can see it.
+ * @param {Object} result
+ * @returns {Object} result
+ */
+function hideTiming(result) {
+  if (result !== null && typeof result === 'object' && result.timing !== undefined) {
+    hiddenTimings.set(result, result.timing);
+    delete result.timing;
+  }
+  return result;
+}
+
+/**
+ * Type name of a bound parameter, as reported in slow query entries.
+ * @param {*} value
+ * @returns {string}
+ */
+function paramType(value) {
+  if (value === null || value === undefined) {
+    return 'null';
+  }
+  if (Buffer.isBuffer(value)) {
+    return 'Buffer';
+  }
+  if (value instanceof Date) {
+    return 'Date';
+  }
+  return typeof value;
+}
+
+function defaultSink(entry) {
+  console.warn(`[mimer] slow ${entry.operation} (${entry.durationMs.toFixed(1)} ms): `
+    + entry.fingerprint);
+}
+
+/**
+ * Reports statements slower than a threshold to a sink. The calling stack
+ * is only captured for a slow statement, once it has finished; V8's async
+ * stack traces still lead back to the caller when it awaits the call.
+ */
+class SlowQueryLog {
+  /**
+   * @param {Object} options
+   * @param {number} options.thresholdMs - Report statements taking longer
+   * @param {Function} [options.sink] - (entry) => void, default console.warn
+   * @param {boolean} [options.redact=true] - Leave parameter values out
+   */
+  constructor(options) {
+    const { thresholdMs, sink, redact } = options;
+    if (typeof thresholdMs !== 'number' || !(thresholdMs >= 0)) {
+      throw new TypeError('slowQuery.thresholdMs must be a non-negative number');
+    }
+    if (sink !== undefined && typeof sink !== 'function') {
+      throw new TypeError('slowQuery.sink must be a function');
+    }
+    this.thresholdMs = thresholdMs;
+    this._sink = sink || defaultSink;
+    this._redact = redact !== false;
+  }
+
+  /**
+   * Wrap `fn` so a call slower than the threshold is reported.
+   * @param {string} operation - 'query', 'execute' or 'cursor'
+   * @param {string} sql
+   * @param {Array} params - Parameter values, or parameter sets for executeMany
+   * @param {Function} fn - async (context) => result
+   * @returns {Function}
+   */
+  wrap(operation, sql, params, fn) {
+    return async (context) => {
+      const start = process.hrtime.bigint();
+      let result;
+      let error = null;
+      try {
+        result = await fn(context);
+        return result;
+      } catch (err) {
+        error = err;
+        throw err;
+      } finally {
+        const durationMs = elapsedMs(start);
+        if (durationMs > this.thresholdMs) {
+          this._report(operation, sql, params, durationMs, result, error);
+        }
+      }
+    };
+  }
+
+  _report(operation, sql, params, durationMs, result, error) {
+    const isObject = result !== null && typeof result === 'object';
+    const entry = {
+      operation,
+      sql,
+      fingerprint: fingerprint(sql),
+      durationMs,
+      rowCount: isObject && typeof result.rowCount === 'number' ? result.rowCount : null,
+      timing: isObject ? result.timing || hiddenTimings.get(result) || null : null,
+      paramTypes: Array.isArray(params)
+        ? params.map((p) => (Array.isArray(p) ? p.map(paramType) : paramType(p)))
+        : [],
+      error: error !== null ? error.message : null,
+      stack: callerStack(),
+    };
+    if (!this._redact) {
+      entry.params = params;
+    }
+    try {
+      this._sink(entry);
+    } catch (err) {
+      // A failing sink must not fail the statement
+    }
+  }
+}
+
+/**
+ * The current stack without its header line and the driver's own frames.
+ * @returns {string}
+ */
+function callerStack() {
+  const lines = new Error().stack.split('\n');
+  return lines.slice(1).filter((line) => !line.includes(DRIVER_DIR)).join('\n');
+}
+
+/**
+ * Wrap `fn` with `log`, or return it unchanged when there is no log.
+ * @param {SlowQueryLog|null} log
+ * @returns {Function}
+ */
+function watchSlow(log, operation, sql, params, fn) {
+  return log === null ? fn : log.wrap(operation, sql, params, fn);
+}
+
+/**
+ * Build a SlowQueryLog from a `slowQuery` option.
+ * @param {Object|SlowQueryLog|undefined} option
+ * @returns {SlowQueryLog|null}
+ */
+function createSlowQueryLog(option) {
+  if (!option) {
+    return null;
+  }
+  return option instanceof SlowQueryLog ? option : new SlowQueryLog(option);
+}
+
+module.exports = { SlowQueryLog, createSlowQueryLog, watchSlow, hideTiming };
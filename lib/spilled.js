@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+/**
+ * SpilledRows stands in for the rows array of a result fetched with
+ * { spill }. Rows beyond the memory budget live in a temporary file and
+ * are decoded one at a time, so only the row being read is a JS object.
+ * Call close() to release the file; it is also removed on garbage
+ * collection and process exit.
+ */
+class SpilledRows {
+  constructor(nativeRows) {
+    this._rows = nativeRows;
+    this.length = nativeRows.getLength();
+  }
+
+  /**
+   * True if any rows were written to the temporary file.
+   * @returns {boolean}
+   */
+  get spilled() {
+    return this._rows.isSpilled();
+  }
+
+  /**
+   * Decode one row.
+   * @param {number} index - Row index, 0 <= index < length
+   * @returns {Object} Row object
+   */
+  get(index) {
+    return this._rows.get(index);
+  }
+
+  *[Symbol.iterator]() {
+    for (let i = 0; i < this.length; i++) {
+      yield this._rows.get(i);
+    }
+  }
+
+  /**
+   * Release the memory buffer and remove the temporary file.
+   */
+  close() {
+    this._rows.close();
+  }
+}
+
+/**
+ * Replace the native spilled rows of a result with a SpilledRows wrapper.
+ * @private
+ */
+function wrapSpilled(result) {
+  if (result.spilled) {
+    result.rows = new SpilledRows(result.rows);
+  }
+  return result;
+}
+
+module.exports = { SpilledRows, wrapSpilled };
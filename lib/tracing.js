@@ -0,0 +1,192 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+const diagnosticsChannel = require('node:diagnostics_channel');
+const mimer = require('./native');
+
+/**
+ * Tracing channels, one per operation. Subscribe with
+ * diagnostics_channel.tracingChannel('mimer:<operation>'). On Node
+ * versions without TracingChannel every entry is null and nothing is
+ * published.
+ */
+const OPERATIONS = [
+  'connect', 'query', 'prepare', 'execute', 'fetch', 'commit', 'rollback', 'acquire',
+];
+
+const channels = {};
+for (const operation of OPERATIONS) {
+  channels[operation] = typeof diagnosticsChannel.tracingChannel === 'function'
+    ? diagnosticsChannel.tracingChannel(`mimer:${operation}`)
+    : null;
+}
+
+// Operations whose results are query results ({ rows, rowCount, timing });
+// the others resolve to rows, result sets or clients, whose properties
+// must not be mistaken for them
+const RESULT_CHANNELS = new Set([channels.query, channels.execute]);
+
+const FINGERPRINT_CACHE_SIZE = 1000;
+const fingerprints = new Map();
+
+// Whichever of a literal, quoted identifier or comment starts first wins,
+// so quotes inside comments and comment markers inside literals are inert
+const LITERAL_OR_COMMENT_RE =
+  /(?:\b[xXnN])?'(?:''|[^'])*'|"(?:""|[^"])*"|--[^\n]*|\/\*[\s\S]*?\*\//g;
+
+function replaceLiteralOrComment(match) {
+  if (match[0] === '"') {
+    return match;
+  }
+  return match[0] === '-' || match[0] === '/' ? ' ' : '?';
+}
+
+/**
+ * Normalize SQL so statements that differ only in literal values compare
+ * equal: string, hex and numeric literals become ?, IN lists of any length
+ * collapse to (?), comments are dropped and whitespace is collapsed.
+ * @param {string} sql
+ * @returns {string}
+ */
+function fingerprint(sql) {
+  let result = fingerprints.get(sql);
+  if (result !== undefined) {
+    return result;
+  }
+  result = sql
+    .replace(LITERAL_OR_COMMENT_RE, replaceLiteralOrComment)
+    .replace(/\b\d+(?:\.\d+)?(?:[eE][+-]?\d+)?\b/g, '?')
+    .replace(/\(\s*\?(?:\s*,\s*\?)*\s*\)/g, '(?)')
+    .replace(/\s+/g, ' ')
+    .trim();
+  // Bounded, so ad hoc SQL with inlined values cannot grow it forever
+  if (fingerprints.size >= FINGERPRINT_CACHE_SIZE) {
+    fingerprints.clear();
+  }
+  fingerprints.set(sql, result);
+  return result;
+}
+
+function hasSubscribers(channel) {
+  if (channel.hasSubscribers !== undefined) {
+    return channel.hasSubscribers;
+  }
+  return channel.start.hasSubscribers || channel.end.hasSubscribers
+    || channel.asyncStart.hasSubscribers || channel.asyncEnd.hasSubscribers
+    || channel.error.hasSubscribers;
+}
+
+/**
+ * Run `fn` under a tracing channel. When nobody subscribes this is a plain
+ * call: `makeContext` is not invoked and `fn` receives null. Otherwise the
+ * start/end/asyncStart/asyncEnd/error events share one context object.
+ * For query and execute it gets `rowCount` and `timing` from the result
+ * when it has them; other operations set what they report on the context.
+ * @param {TracingChannel|null} channel
+ * @param {Function} makeContext - () => context object
+ * @param {Function} fn - async (context) => result
+ * @returns {Promise<*>}
+ */
+function trace(channel, makeContext, fn) {
+  if (channel === null || !hasSubscribers(channel)) {
+    return fn(null);
+  }
+  const context = makeContext();
+  return channel.tracePromise(async () => {
+    const result = await fn(context);
+    if (result !== null && typeof result === 'object' && RESULT_CHANNELS.has(channel)) {
+      if (result.rowCount !== undefined) {
+        context.rowCount = result.rowCount;
+      }
+      if (result.timing !== undefined) {
+        context.timing = result.timing;
+      }
+    }
+    return result;
+  }, context);
+}
+
+/**
+ * Context for an operation on a SQL statement.
+ * @param {string} sql
+ * @returns {Object} { sql, fingerprint }
+ */
+function sqlContext(sql) {
+  return { sql, fingerprint: typeof sql === 'string' ? fingerprint(sql) : null };
+}
+
+/**
+ * Milliseconds elapsed since a process.hrtime.bigint() reading.
+ * @param {bigint} start
+ * @returns {number}
+ */
+function elapsedMs(start) {
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+/**
+ * Add one call to the native statement statistics table.
+ * @param {string} sql
+ * @param {number} ms - Latency in milliseconds
+ * @param {number} rows - Rows returned or affected
+ * @param {boolean} failed
+ */
+function recordStatement(sql, ms, rows, failed) {
+  if (typeof sql === 'string') {
+    mimer.recordStatement(fingerprint(sql), ms, rows, failed);
+  }
+}
+
+/**
+ * Wrap `fn` so each call is recorded in the statement statistics table
+ * under the fingerprint of `sql`, with the result's rowCount. Returns `fn`
+ * itself when `enabled` is false.
+ * @param {boolean} enabled
+ * @param {string} sql
+ * @param {Function} fn - async (context) => result
+ * @returns {Function}
+ */
+function measured(enabled, sql, fn) {
+  if (!enabled) {
+    return fn;
+  }
+  return async (context) => {
+    const start = process.hrtime.bigint();
+    let rows = 0;
+    let failed = true;
+    try {
+      const result = await fn(context);
+      if (result !== null && typeof result === 'object'
+          && typeof result.rowCount === 'number') {
+        rows = result.rowCount;
+      }
+      failed = false;
+      return result;
+    } finally {
+      recordStatement(sql, elapsedMs(start), rows, failed);
+    }
+  };
+}
+
+module.exports = {
+  channels, trace, sqlContext, fingerprint, elapsedMs, recordStatement, measured,
+};
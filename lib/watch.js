@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+'use strict';
+
+const { EventEmitter } = require('events');
+
+/**
+ * QueryWatcher re-executes a SELECT on an interval and emits only the rows
+ * that changed since the previous run.
+ *
+ * The query runs on one prepared statement. Rows are hashed natively and
+ * compared with the previous snapshot by key, so unchanged rows are never
+ * turned into JS objects. The first poll reports every row as inserted.
+ *
+ * Events:
+ *   'change' ({ inserted, updated, deleted }) - only emitted when something
+ *            changed; `deleted` holds key values
+ *   'error'  (err) - a poll failed; polling continues on the next interval.
+ *            Without an 'error' listener the failure is dropped
+ */
+class QueryWatcher extends EventEmitter {
+  /**
+   * @param {MimerClient} client
+   * @param {string} sql - SELECT statement (with optional ? placeholders)
+   * @param {Array} params - Parameter values, bound on every poll
+   * @param {Object} options
+   * @param {string} options.key - Column that uniquely identifies a row
+   * @param {number} [options.intervalMs=1000] - Delay between polls
+   *   (0 = no automatic polling, call poll() yourself)
+   */
+  constructor(client, sql, params = [], options = {}) {
+    super();
+    if (!options.key) {
+      throw new Error('watch() requires a key column');
+    }
+    this._key = options.key;
+    this._params = params;
+    this._intervalMs = options.intervalMs !== undefined ? options.intervalMs : 1000;
+    this._stmt = client.connection.prepare(sql);
+    this._closed = false;
+
+    // First poll is deferred so the caller can attach listeners
+    this._timer = null;
+    if (this._intervalMs > 0) {
+      this._timer = setTimeout(() => this._tick(), 0);
+    }
+  }
+
+  /**
+   * Run one poll now. Emits 'change' if anything changed.
+   * @returns {Promise<Object>} { inserted, updated, deleted, rowCount }
+   */
+  async poll() {
+    if (this._closed) {
+      throw new Error('Watcher is closed');
+    }
+    const diff = this._stmt.executeDiff(this._params, this._key);
+    if (diff.inserted.length > 0 || diff.updated.length > 0 || diff.deleted.length > 0) {
+      this.emit('change', diff);
+    }
+    return diff;
+  }
+
+  _tick() {
+    this._timer = null;
+    if (this._closed) {
+      return;
+    }
+    this.poll()
+      .catch((err) => {
+        // emit('error') throws when nobody listens, which would leave an
+        // unhandled rejection behind
+        if (this.listenerCount('error') > 0) {
+          this.emit('error', err);
+        }
+      })
+      .finally(() => {
+        if (!this._closed) {
+          this._timer = setTimeout(() => this._tick(), this._intervalMs);
+        }
+      });
+  }
+
+  /**
+   * Stop polling and release the prepared statement.
+   */
+  close() {
+    if (this._closed) {
+      return;
+    }
+    this._closed = true;
+    if (this._timer !== null) {
+      clearTimeout(this._timer);
+      this._timer = null;
+    }
+    this._stmt.close();
+  }
+}
+
+module.exports = { QueryWatcher };
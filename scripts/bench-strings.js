@@ -0,0 +1,79 @@
+#!/usr/bin/env node
+/**
+ * Microbenchmark for text column decoding.
+ *
+ * Fills a table with ASCII and non-ASCII VARCHAR values of typical widths
+ * and times how long query() takes to materialize each column. Run before
+ * and after a change to the fetch path to compare.
+ *
+ *   node scripts/bench-strings.js [rows]
+ *
+ * Connects with MIMER_DSN / MIMER_USER / MIMER_PASSWORD (defaults match
+ * the test suite).
+ */
+
+const { connect } = require('../index');
+
+const ROWS = Number(process.argv[2]) || 20000;
+const WIDTHS = [8, 32, 128, 255];
+const ROUNDS = 5;
+const TABLE = 'bench_strings';
+
+function value(width, i, ascii) {
+  const base = (ascii ? 'abcdefghij' : 'åäöüéßñçøæ') + i;
+  return base.repeat(Math.ceil(width / base.length)).slice(0, width);
+}
+
+async function main() {
+  const client = await connect({
+    dsn: process.env.MIMER_DSN || 'mimerdb',
+    user: process.env.MIMER_USER || 'SYSADM',
+    password: process.env.MIMER_PASSWORD || 'SYSADM',
+  });
+
+  try {
+    await client.query(`DROP TABLE ${TABLE}`);
+  } catch (e) {
+    // Table did not exist
+  }
+
+  const columns = WIDTHS.flatMap((w) => [`a${w} NVARCHAR(${w})`, `u${w} NVARCHAR(${w})`]);
+  await client.query(`CREATE TABLE ${TABLE} (${columns.join(', ')})`);
+
+  const placeholders = columns.map(() => '?').join(', ');
+  const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (${placeholders})`);
+  const sets = [];
+  for (let i = 0; i < ROWS; i++) {
+    sets.push(WIDTHS.flatMap((w) => [value(w, i, true), value(w, i, false)]));
+  }
+  await stmt.executeMany(sets);
+  await stmt.close();
+
+  console.log(`${ROWS} rows, best of ${ROUNDS} rounds\n`);
+  console.log('column  width  ms      ns/value');
+  for (const width of WIDTHS) {
+    for (const prefix of ['a', 'u']) {
+      const sql = `SELECT ${prefix}${width} FROM ${TABLE}`;
+      let best = Infinity;
+      for (let r = 0; r < ROUNDS; r++) {
+        const start = process.hrtime.bigint();
+        await client.query(sql);
+        const ms = Number(process.hrtime.bigint() - start) / 1e6;
+        best = Math.min(best, ms);
+      }
+      const label = prefix === 'a' ? 'ascii' : 'utf-8';
+      console.log(
+        `${label.padEnd(8)}${String(width).padEnd(7)}${best.toFixed(1).padEnd(8)}` +
+        `${(best * 1e6 / ROWS).toFixed(0)}`
+      );
+    }
+  }
+
+  await client.query(`DROP TABLE ${TABLE}`);
+  await client.close();
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
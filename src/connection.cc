@@ -24,6 +24,7 @@
 #include "statement.h"
 #include "resultset.h"
 #include "helpers.h"
+#include "spill.h"
 #include <sstream>
 #include <cstring>
 #include <cstdlib>
@@ -41,7 +42,12 @@ Napi::Object MimerConnection::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("rollback", &MimerConnection::Rollback),
     InstanceMethod("isConnected", &MimerConnection::IsConnected),
     InstanceMethod("prepare", &MimerConnection::Prepare),
-    InstanceMethod("executeQuery", &MimerConnection::ExecuteQuery)
+    InstanceMethod("executeQuery", &MimerConnection::ExecuteQuery),
+    InstanceMethod("executeScript", &MimerConnection::ExecuteScript),
+    InstanceMethod("setFetchLimits", &MimerConnection::SetFetchLimits),
+    InstanceMethod("setTiming", &MimerConnection::SetTiming),
+    InstanceMethod("getTimingStats", &MimerConnection::GetTimingStats),
+    InstanceMethod("getStats", &MimerConnection::GetStats)
   });
 
   Napi::FunctionReference* constructor = new Napi::FunctionReference();
@@ -169,8 +175,11 @@ Napi::Value MimerConnection::Close(const Napi::CallbackInfo& info) {
 
 /**
  * Execute SQL statement
- * Arguments: sql (string), params (optional array)
- * Returns: result object with rows and metadata
+ * Arguments: sql (string), params (optional array),
+ *            options (optional object: maxRows, maxBytes, onLimit, timing)
+ * Returns: result object with rows and metadata; `truncated` is set when
+ *          a limit cut the result short in truncate mode, `timing` when
+ *          phase timing is on
  */
 Napi::Value MimerConnection::Execute(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -189,13 +198,32 @@ Napi::Value MimerConnection::Execute(const Napi::CallbackInfo& info) {
 
   std::string sql = info[0].As<Napi::String>().Utf8Value();
 
+  FetchLimits limits = fetchLimits_;
+  SpillOptions spill;
+  DecodeOptions decode;
+  if (info.Length() >= 3 && (!ParseFetchLimits(env, info[2], limits) ||
+                             !ParseSpillOptions(env, info[2], spill) ||
+                             !ParseDecodeOptions(env, info[2], decode))) {
+    return env.Undefined();
+  }
+  bool timed = timing_;
+  if (info.Length() >= 3) {
+    ParseTiming(info[2], timed);
+  }
+  PhaseTiming timing;
+  PhaseTiming* timer = timed ? &timing : nullptr;
+  ScopedStats stats(&stats_);
+
   // Check for optional params array
   bool hasParams = (info.Length() >= 2 && info[1].IsArray()
                     && info[1].As<Napi::Array>().Length() > 0);
 
   // Try to prepare the statement using the UTF-8 variant
   MimerStatement stmt = MIMERNULLHANDLE;
-  int rc = MimerBeginStatement8(session_, sql.c_str(), MIMER_FORWARD_ONLY, &stmt);
+  int rc = BeginStatement(sql, &stmt);
+  if (timer) {
+    timer->Lap(timer->prepare);
+  }
 
   // DDL statements (CREATE, DROP, ALTER, etc.) cannot be prepared.
   // Fall back to direct execution via MimerExecuteStatement8.
@@ -207,6 +235,11 @@ Napi::Value MimerConnection::Execute(const Napi::CallbackInfo& info) {
       return env.Undefined();
     }
     result.Set("rowCount", Napi::Number::New(env, 0));
+    if (timer) {
+      timer->Lap(timer->execute);
+      timingTotals_.Add(timing);
+      result.Set("timing", timing.ToObject(env));
+    }
     return result;
   }
 
@@ -218,12 +251,15 @@ Napi::Value MimerConnection::Execute(const Napi::CallbackInfo& info) {
   // Bind parameters if provided
   if (hasParams) {
     Napi::Array params = info[1].As<Napi::Array>();
-    BindParameters(env, stmt, params);
+    BindParameters(env, stmt, params, &stats);
     if (env.IsExceptionPending()) {
-      MimerEndStatement(&stmt);
+      EndStatement(&stmt);
       return env.Undefined();
     }
   }
+  if (timer) {
+    timer->Lap(timer->bind);
+  }
 
   // Use MimerColumnCount to determine if this is a SELECT (has result columns)
   int columnCount = MimerColumnCount(stmt);
@@ -234,35 +270,144 @@ Napi::Value MimerConnection::Execute(const Napi::CallbackInfo& info) {
   if (hasResultSet) {
     // Build column metadata before fetching rows
     result.Set("fields", BuildFieldsArray(env, stmt, columnCount));
+    if (timer) {
+      timer->Lap(timer->convert);
+    }
 
     // Open cursor for SELECT statements
-    rc = MimerOpenCursor(stmt);
+    rc = OpenCursor(stmt);
     if (rc < 0) {
       CheckError(rc, "MimerOpenCursor");
-      MimerEndStatement(&stmt);
+      EndStatement(&stmt);
       return env.Undefined();
     }
+    if (timer) {
+      timer->Lap(timer->execute);
+    }
 
-    Napi::Array rows = FetchResults(env, stmt, columnCount);
+    std::vector<std::string> colNames;
+    std::vector<int> colTypes;
+    CacheColumnMetadata(stmt, columnCount, colNames, colTypes);
+
+    bool truncated = false;
+    size_t rowCount = 0;
+    FetchContext context(env, colNames, colTypes, decode);
+    context.timing = timer;
+    context.stats = &stats;
+    Napi::Value rows;
+    try {
+      if (spill.enabled) {
+        rows = FetchSpilled(env, stmt, columnCount, colNames, colTypes,
+                            spill, limits, &truncated, &rowCount);
+        stats.Count(STAT_ROWS_FETCHED, rowCount);
+        if (timer) {
+          timer->Lap(timer->fetch);
+          timer->rows = rowCount;
+        }
+      } else if (decode.Shaped()) {
+        rows = FetchShaped(env, stmt, columnCount, colNames, colTypes,
+                           limits, &truncated, &context, decode, &rowCount);
+      } else {
+        Napi::Array array = FetchResults(env, stmt, columnCount, colNames, colTypes,
+                                         limits, &truncated, &context);
+        rowCount = array.Length();
+        rows = array;
+      }
+    } catch (const Napi::Error&) {
+      // JS code run during the fetch (e.g. a rowFactory constructor) threw
+      EndStatement(&stmt);
+      throw;
+    }
+    if (env.IsExceptionPending()) {
+      EndStatement(&stmt);
+      return env.Undefined();
+    }
     result.Set("rows", rows);
-    result.Set("rowCount", Napi::Number::New(env, rows.Length()));
+    result.Set("rowCount", Napi::Number::New(env, static_cast<double>(rowCount)));
+    if (spill.enabled) {
+      result.Set("spilled", Napi::Boolean::New(env, true));
+    }
+    if (truncated) {
+      result.Set("truncated", Napi::Boolean::New(env, true));
+    }
   } else {
     // DML statement (INSERT, UPDATE, DELETE)
     rc = MimerExecute(stmt);
     if (rc < 0) {
       CheckError(rc, "MimerExecute");
-      MimerEndStatement(&stmt);
+      EndStatement(&stmt);
       return env.Undefined();
     }
     result.Set("rowCount", Napi::Number::New(env, rc));
+    if (timer) {
+      timer->Lap(timer->execute);
+    }
   }
 
   // Clean up statement
-  MimerEndStatement(&stmt);
+  EndStatement(&stmt);
+
+  if (timer) {
+    timingTotals_.Add(timing);
+    result.Set("timing", timing.ToObject(env));
+  }
 
   return result;
 }
 
+/**
+ * Set the connection's default result limits for execute() and prepared
+ * statements. Arguments: options ({ maxRows, maxBytes, onLimit }); limits
+ * not given are reset to unlimited / 'error'.
+ */
+Napi::Value MimerConnection::SetFetchLimits(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  FetchLimits limits;
+  if (info.Length() >= 1 && !ParseFetchLimits(env, info[0], limits)) {
+    return env.Undefined();
+  }
+  fetchLimits_ = limits;
+
+  return Napi::Boolean::New(env, true);
+}
+
+/**
+ * Turn phase timing on or off for every execute() on this connection and
+ * its prepared statements. Arguments: enabled (boolean)
+ */
+Napi::Value MimerConnection::SetTiming(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  timing_ = info.Length() >= 1 && info[0].ToBoolean().Value();
+  return Napi::Boolean::New(env, true);
+}
+
+/**
+ * Phase timing summed over the timed statements of this connection.
+ * Arguments: reset (optional boolean) clears the totals after reading.
+ * Returns: { statements, prepare, bind, execute, fetch, convert, total,
+ *            rows, bytes }
+ */
+Napi::Value MimerConnection::GetTimingStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = timingTotals_.ToObject(env);
+  stats.Set("statements", Napi::Number::New(env, static_cast<double>(timingTotals_.statements)));
+  if (info.Length() >= 1 && info[0].ToBoolean().Value()) {
+    timingTotals_ = PhaseTiming();
+  }
+  return stats;
+}
+
+/**
+ * Operation counters for this connection and its statements and result
+ * sets: statements prepared and ended, cursors opened, rows fetched, cells
+ * decoded per type, bytes of strings/Buffers/LOBs produced, and parameter
+ * binds per type. Module-level getStats() returns the process totals.
+ */
+Napi::Value MimerConnection::GetStats(const Napi::CallbackInfo& info) {
+  return stats_.ToObject(info.Env());
+}
+
 /**
  * Begin a transaction
  */
@@ -362,6 +507,7 @@ Napi::Value MimerConnection::Prepare(const Napi::CallbackInfo& info) {
   MimerStmtWrapper* stmt = MimerStmtWrapper::Unwrap(stmtObj);
   stmt->SetParentConnection(this);
   openStatements_.insert(stmt);
+  CountOperation(&stats_, STAT_STATEMENTS_PREPARED);
 
   return stmtObj;
 }
@@ -391,7 +537,7 @@ Napi::Value MimerConnection::ExecuteQuery(const Napi::CallbackInfo& info) {
                     && info[1].As<Napi::Array>().Length() > 0);
 
   MimerStatement stmt = MIMERNULLHANDLE;
-  int rc = MimerBeginStatement8(session_, sql.c_str(), MIMER_FORWARD_ONLY, &stmt);
+  int rc = BeginStatement(sql, &stmt);
 
   if (rc == MIMER_STATEMENT_CANNOT_BE_PREPARED) {
     Napi::Error::New(env, "queryCursor only supports SELECT statements (DDL cannot be prepared)")
@@ -407,26 +553,27 @@ Napi::Value MimerConnection::ExecuteQuery(const Napi::CallbackInfo& info) {
   // Bind parameters if provided
   if (hasParams) {
     Napi::Array params = info[1].As<Napi::Array>();
-    BindParameters(env, stmt, params);
+    ScopedStats stats(&stats_);
+    BindParameters(env, stmt, params, &stats);
     if (env.IsExceptionPending()) {
-      MimerEndStatement(&stmt);
+      EndStatement(&stmt);
       return env.Undefined();
     }
   }
 
   int columnCount = MimerColumnCount(stmt);
   if (columnCount <= 0) {
-    MimerEndStatement(&stmt);
+    EndStatement(&stmt);
     Napi::Error::New(env, "queryCursor only supports SELECT statements (DML has no result columns)")
         .ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
   // Open cursor
-  rc = MimerOpenCursor(stmt);
+  rc = OpenCursor(stmt);
   if (rc < 0) {
     CheckError(rc, "MimerOpenCursor");
-    MimerEndStatement(&stmt);
+    EndStatement(&stmt);
     return env.Undefined();
   }
 
@@ -434,7 +581,7 @@ Napi::Value MimerConnection::ExecuteQuery(const Napi::CallbackInfo& info) {
   Napi::Object rsObj = MimerResultSetWrapper::NewInstance(env, stmt, columnCount);
   if (env.IsExceptionPending()) {
     MimerCloseCursor(stmt);
-    MimerEndStatement(&stmt);
+    EndStatement(&stmt);
     return env.Undefined();
   }
 
@@ -446,6 +593,208 @@ Napi::Value MimerConnection::ExecuteQuery(const Napi::CallbackInfo& info) {
   return rsObj;
 }
 
+/**
+ * Execute a script of SQL statements in one native call.
+ * Arguments: script (string, split on top-level ';', or array of strings),
+ *            options (optional object: stopOnError = true, transaction = false)
+ * Returns: { statementCount, executed, rowCount, errors }
+ *
+ * Statements run without creating JS result objects; SELECTs are executed
+ * but their rows are discarded. With stopOnError the first failure is
+ * thrown with statementIndex and sql set (after rolling back when
+ * transaction is set). Otherwise failures are collected in `errors` and
+ * the remaining statements still run. With transaction, a script that
+ * contains DDL is rejected with a TypeError before any statement runs.
+ */
+Napi::Value MimerConnection::ExecuteScript(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!connected_) {
+    Napi::Error::New(env, "Not connected to database")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::vector<std::string> statements;
+  if (info.Length() >= 1 && info[0].IsString()) {
+    statements = SplitSqlScript(info[0].As<Napi::String>().Utf8Value());
+  } else if (info.Length() >= 1 && info[0].IsArray()) {
+    Napi::Array arr = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < arr.Length(); i++) {
+      Napi::Value v = arr.Get(i);
+      if (!v.IsString()) {
+        Napi::TypeError::New(env, "Expected an array of SQL strings")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      statements.push_back(v.As<Napi::String>().Utf8Value());
+    }
+  } else {
+    Napi::TypeError::New(env, "Expected SQL script string or array of SQL strings")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  bool stopOnError = true;
+  bool transaction = false;
+  if (info.Length() >= 2 && info[1].IsObject()) {
+    Napi::Object opts = info[1].As<Napi::Object>();
+    Napi::Value v = opts.Get("stopOnError");
+    if (!v.IsUndefined()) {
+      stopOnError = v.ToBoolean().Value();
+    }
+    transaction = opts.Get("transaction").ToBoolean().Value();
+  }
+
+  // DDL commits on its own and would escape the rollback, so a script
+  // that needs one transaction must be DML only. Checked before anything runs.
+  if (transaction) {
+    for (size_t i = 0; i < statements.size(); i++) {
+      if (IsSqlDataDefinition(statements[i])) {
+        Napi::TypeError error = Napi::TypeError::New(
+            env, "executeScript() with transaction cannot run DDL (statement " +
+                     std::to_string(i) + ")");
+        error.Set("statementIndex", Napi::Number::New(env, static_cast<double>(i)));
+        error.Set("sql", Napi::String::New(env, statements[i]));
+        error.ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+    }
+  }
+
+  int rc;
+  if (transaction) {
+    rc = MimerBeginTransaction(session_, MIMER_TRANS_READWRITE);
+    if (rc < 0) {
+      CheckError(rc, "MimerBeginTransaction");
+      return env.Undefined();
+    }
+  }
+
+  Napi::Array errors = Napi::Array::New(env);
+  uint32_t errorCount = 0;
+  uint32_t executed = 0;
+  double rowCount = 0;
+
+  for (size_t i = 0; i < statements.size(); i++) {
+    int affected = 0;
+    std::string operation;
+    std::string detail;
+    rc = RunScriptStatement(statements[i], affected, operation, detail);
+
+    if (rc >= 0) {
+      executed++;
+      rowCount += affected;
+      continue;
+    }
+
+    Napi::Error error = MakeMimerError(env, rc, operation, detail);
+    error.Set("statementIndex", Napi::Number::New(env, static_cast<double>(i)));
+    error.Set("sql", Napi::String::New(env, statements[i]));
+
+    if (stopOnError) {
+      if (transaction) {
+        MimerEndTransaction(session_, MIMER_ROLLBACK);
+      }
+      error.ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    errors.Set(errorCount++, error.Value());
+  }
+
+  if (transaction) {
+    rc = MimerEndTransaction(session_, MIMER_COMMIT);
+    if (rc < 0) {
+      CheckError(rc, "MimerEndTransaction (commit)");
+      return env.Undefined();
+    }
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("statementCount", Napi::Number::New(env, static_cast<double>(statements.size())));
+  result.Set("executed", Napi::Number::New(env, executed));
+  result.Set("rowCount", Napi::Number::New(env, rowCount));
+  result.Set("errors", errors);
+  return result;
+}
+
+/**
+ * Run one script statement without building any JS values. Mirrors the
+ * prepare / direct-execute fallback in Execute(). On failure, operation
+ * and detail describe the error (read before the statement is ended).
+ */
+int MimerConnection::RunScriptStatement(const std::string& sql, int& rowCount,
+                                        std::string& operation,
+                                        std::string& detail) {
+  MimerStatement stmt = MIMERNULLHANDLE;
+  operation = "MimerBeginStatement8";
+  int rc = BeginStatement(sql, &stmt);
+
+  if (rc == MIMER_STATEMENT_CANNOT_BE_PREPARED) {
+    operation = "MimerExecuteStatement8";
+    rc = MimerExecuteStatement8(session_, sql.c_str());
+    if (rc < 0) {
+      detail = GetErrorMessage();
+    }
+    return rc;
+  }
+
+  if (rc < 0) {
+    detail = GetErrorMessage();
+    return rc;
+  }
+
+  if (MimerColumnCount(stmt) > 0) {
+    operation = "MimerOpenCursor";
+    rc = OpenCursor(stmt);
+    if (rc >= 0) {
+      MimerCloseCursor(stmt);
+    }
+  } else {
+    operation = "MimerExecute";
+    rc = MimerExecute(stmt);
+    if (rc >= 0) {
+      rowCount = rc;
+    }
+  }
+
+  if (rc < 0) {
+    detail = GetErrorMessage();
+  }
+  EndStatement(&stmt);
+  return rc;
+}
+
+/**
+ * MimerBeginStatement8 on this session, counting statements prepared.
+ */
+int MimerConnection::BeginStatement(const std::string& sql, MimerStatement* stmt) {
+  int rc = MimerBeginStatement8(session_, sql.c_str(), MIMER_FORWARD_ONLY, stmt);
+  if (rc >= 0) {
+    CountOperation(&stats_, STAT_STATEMENTS_PREPARED);
+  }
+  return rc;
+}
+
+/**
+ * MimerOpenCursor, counting cursors opened.
+ */
+int MimerConnection::OpenCursor(MimerStatement stmt) {
+  int rc = MimerOpenCursor(stmt);
+  if (rc >= 0) {
+    CountOperation(&stats_, STAT_CURSORS_OPENED);
+  }
+  return rc;
+}
+
+/**
+ * MimerEndStatement, counting statements ended.
+ */
+void MimerConnection::EndStatement(MimerStatement* stmt) {
+  MimerEndStatement(stmt);
+  CountOperation(&stats_, STAT_STATEMENTS_ENDED);
+}
+
 /**
  * Check for errors and throw structured JavaScript exception if error occurred
  */
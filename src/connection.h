@@ -27,6 +27,8 @@
 #include <mimerapi.h>
 #include <string>
 #include <set>
+#include <vector>
+#include "helpers.h"
 
 class MimerStmtWrapper; // forward declaration
 class MimerResultSetWrapper; // forward declaration
@@ -49,6 +51,16 @@ public:
   void RegisterResultSet(MimerResultSetWrapper* rs);
   void UnregisterResultSet(MimerResultSetWrapper* rs);
 
+  // Default result limits, read by prepared statements on execute
+  const FetchLimits& GetFetchLimits() const { return fetchLimits_; }
+
+  // Phase timing default and totals, shared with prepared statements
+  bool TimingEnabled() const { return timing_; }
+  void AddTiming(const PhaseTiming& timing) { timingTotals_.Add(timing); }
+
+  // Operation counters, also updated by statements and result sets
+  OperationStats* Stats() { return &stats_; }
+
 private:
   // Connection handle
   MimerSession session_;
@@ -58,6 +70,16 @@ private:
   std::set<MimerStmtWrapper*> openStatements_;
   std::set<MimerResultSetWrapper*> openResultSets_;
 
+  // Connection-wide default for maxRows / maxBytes / onLimit
+  FetchLimits fetchLimits_;
+
+  // Time every statement by default, and the sum over timed statements
+  bool timing_ = false;
+  PhaseTiming timingTotals_;
+
+  // Operation counters for getStats()
+  OperationStats stats_;
+
   // Methods exposed to JavaScript
   Napi::Value Connect(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
@@ -68,10 +90,28 @@ private:
   Napi::Value IsConnected(const Napi::CallbackInfo& info);
   Napi::Value Prepare(const Napi::CallbackInfo& info);
   Napi::Value ExecuteQuery(const Napi::CallbackInfo& info);
+  Napi::Value ExecuteScript(const Napi::CallbackInfo& info);
+  Napi::Value SetFetchLimits(const Napi::CallbackInfo& info);
+  Napi::Value SetTiming(const Napi::CallbackInfo& info);
+  Napi::Value GetTimingStats(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
 
   // Helper methods
+  int BeginStatement(const std::string& sql, MimerStatement* stmt);
+  int OpenCursor(MimerStatement stmt);
+  void EndStatement(MimerStatement* stmt);
   void CheckError(int rc, const std::string& operation);
   std::string GetErrorMessage();
+  int RunScriptStatement(const std::string& sql, int& rowCount,
+                         std::string& operation, std::string& detail);
 };
 
+/**
+ * Counters of `conn`, or nullptr for a statement or result set that has
+ * outlived its connection (only the process totals are updated then).
+ */
+inline OperationStats* ConnectionStats(MimerConnection* conn) {
+  return conn ? conn->Stats() : nullptr;
+}
+
 #endif // MIMER_CONNECTION_H
@@ -22,14 +22,29 @@
 
 #include "helpers.h"
 #include <cstring>
+#include <cstdio>
 #include <sstream>
 #include <cmath>
+#include <cctype>
 #include <climits>
 #include <vector>
 #include <string>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
 
 static constexpr size_t LOB_READ_CHUNK  = 65536;
 static constexpr size_t LOB_WRITE_CHUNK = 2 * 1024 * 1024;  // 2 MB, well under ~10 MB API limit
+static constexpr size_t BYTE_SLAB_SIZE = 1024 * 1024;       // ArrayBuffer size for binarySlab
+static constexpr size_t EXTERNAL_STRING_MIN = 1024 * 1024;  // CLOBs this large stay native
 
 /**
  * Count the number of UTF-8 characters (code points) in a byte string.
@@ -47,12 +62,32 @@ static size_t Utf8CharCount(const char* s, size_t byteLen) {
   return count;
 }
 
+/**
+ * Byte length of the first `chars` code points of a UTF-8 string.
+ */
+static size_t Utf8PrefixLength(const char* s, size_t byteLen, size_t chars) {
+  size_t i = 0;
+  for (size_t n = 0; n < chars && i < byteLen; n++) {
+    unsigned char c = static_cast<unsigned char>(s[i]);
+    if (c < 0x80)        i += 1;
+    else if ((c & 0xE0) == 0xC0) i += 2;
+    else if ((c & 0xF0) == 0xE0) i += 3;
+    else                  i += 4;
+  }
+  return i < byteLen ? i : byteLen;
+}
+
 /**
  * Create and throw a structured Mimer error.
  * Sets error.mimerCode and error.operation on the JS Error object.
  */
 void ThrowMimerError(Napi::Env env, int rc, const std::string& operation,
                      const std::string& detail) {
+  MakeMimerError(env, rc, operation, detail).ThrowAsJavaScriptException();
+}
+
+Napi::Error MakeMimerError(Napi::Env env, int rc, const std::string& operation,
+                           const std::string& detail) {
   std::ostringstream oss;
   if (detail.empty()) {
     oss << operation << " failed (code: " << rc << ")";
@@ -63,7 +98,7 @@ void ThrowMimerError(Napi::Env env, int rc, const std::string& operation,
   Napi::Error error = Napi::Error::New(env, oss.str());
   error.Set("mimerCode", Napi::Number::New(env, rc));
   error.Set("operation", Napi::String::New(env, operation));
-  error.ThrowAsJavaScriptException();
+  return error;
 }
 
 /**
@@ -183,7 +218,8 @@ Napi::Array BuildFieldsArray(Napi::Env env, MimerStatement stmt, int columnCount
  * Bind a JavaScript array of parameters to a prepared Mimer statement.
  * JS array is 0-indexed, Mimer parameters are 1-indexed.
  */
-void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params) {
+void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params,
+                    OperationStats* stats) {
   int paramCount = MimerParameterCount(stmt);
   int providedCount = static_cast<int>(params.Length());
 
@@ -200,25 +236,32 @@ void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params) {
     Napi::Value val = params[static_cast<uint32_t>(i)];
     int rc;
 
+    StatCounter counter = STAT_BINDS_OTHER;
+
     if (val.IsNull() || val.IsUndefined()) {
+      counter = STAT_BINDS_NULL;
       rc = MimerSetNull(stmt, paramIndex);
     } else if (val.IsBoolean()) {
+      counter = STAT_BINDS_BOOLEAN;
       rc = MimerSetBoolean(stmt, paramIndex, val.As<Napi::Boolean>().Value() ? 1 : 0);
     } else if (val.IsNumber()) {
       double num = val.As<Napi::Number>().DoubleValue();
       // Check if it's an integer value
       if (std::trunc(num) == num && std::isfinite(num)) {
+        counter = STAT_BINDS_INTEGER;
         if (num >= INT32_MIN && num <= INT32_MAX) {
           rc = MimerSetInt32(stmt, paramIndex, static_cast<int32_t>(num));
         } else {
           rc = MimerSetInt64(stmt, paramIndex, static_cast<int64_t>(num));
         }
       } else {
+        counter = STAT_BINDS_DOUBLE;
         rc = MimerSetDouble(stmt, paramIndex, num);
       }
     } else if (val.IsString()) {
       std::string str = val.As<Napi::String>().Utf8Value();
       int ptype = MimerParameterType(stmt, paramIndex);
+      counter = MimerIsNclob(ptype) ? STAT_BINDS_LOB : STAT_BINDS_STRING;
       if (MimerIsNclob(ptype)) {
         MimerLob lobHandle;
         size_t charCount = Utf8CharCount(str.c_str(), str.size());
@@ -245,6 +288,7 @@ void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params) {
     } else if (val.IsBuffer()) {
       Napi::Buffer<uint8_t> buf = val.As<Napi::Buffer<uint8_t>>();
       int ptype = MimerParameterType(stmt, paramIndex);
+      counter = MimerIsBlob(ptype) ? STAT_BINDS_LOB : STAT_BINDS_BUFFER;
       if (MimerIsBlob(ptype)) {
         MimerLob lobHandle;
         rc = MimerSetLob(stmt, paramIndex, buf.Length(), &lobHandle);
@@ -274,6 +318,9 @@ void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params) {
       ThrowMimerError(env, rc, "BindParameters", detail.str());
       return;
     }
+    if (stats) {
+      stats->Count(counter);
+    }
   }
 }
 
@@ -293,148 +340,1537 @@ void CacheColumnMetadata(MimerStatement stmt, int columnCount,
   }
 }
 
+/**
+ * True for CHARACTER, VARCHAR, NCHAR and NVARCHAR columns (not CLOBs).
+ */
+bool IsCharacterType(int type) {
+  int absType = type < 0 ? -type : type;
+  return absType == MIMER_CHARACTER || absType == MIMER_CHARACTER_VARYING ||
+         absType == MIMER_NCHAR || absType == MIMER_NCHAR_VARYING ||
+         absType == MIMER_UTF8;
+}
+
+/**
+ * True if every byte is below 0x80. Checks eight bytes per step.
+ */
+static bool IsAscii(const char* s, size_t length) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, s + i, sizeof(word));
+    if (word & 0x8080808080808080ULL) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
+    if (static_cast<unsigned char>(s[i]) & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Create a JS string from UTF-8 column data. ASCII is also valid Latin-1,
+ * which V8 stores as a one-byte string without decoding, so that common
+ * case skips UTF-8 validation and transcoding.
+ */
+static Napi::String NewTextString(Napi::Env env, const char* data, size_t length) {
+  if (IsAscii(data, length)) {
+    napi_value value;
+    napi_status status = napi_create_string_latin1(env, data, length, &value);
+    NAPI_THROW_IF_FAILED(env, status, Napi::String());
+    return Napi::String(env, value);
+  }
+  return Napi::String::New(env, data, length);
+}
+
+/**
+ * Decode UTF-8 to UTF-16. Invalid sequences become U+FFFD, as they would
+ * in napi_create_string_utf8().
+ */
+static void Utf8ToUtf16(const std::string& in, std::u16string& out) {
+  out.clear();
+  out.reserve(in.size());
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(in.data());
+  const unsigned char* end = p + in.size();
+
+  while (p < end) {
+    uint32_t c = *p;
+    size_t extra;
+    uint32_t min;
+    if (c < 0x80) {
+      out.push_back(static_cast<char16_t>(c));
+      p++;
+      continue;
+    } else if ((c & 0xE0) == 0xC0) {
+      extra = 1; min = 0x80; c &= 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+      extra = 2; min = 0x800; c &= 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+      extra = 3; min = 0x10000; c &= 0x07;
+    } else {
+      out.push_back(u'\uFFFD');
+      p++;
+      continue;
+    }
+
+    size_t i = 1;
+    for (; i <= extra && p + i < end && (p[i] & 0xC0) == 0x80; i++) {
+      c = (c << 6) | (p[i] & 0x3F);
+    }
+    if (i <= extra || c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+      out.push_back(u'\uFFFD');
+      p += i;
+      continue;
+    }
+    p += i;
+
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      out.push_back(static_cast<char16_t>(0xD800 + (c >> 10)));
+      out.push_back(static_cast<char16_t>(0xDC00 + (c & 0x3FF)));
+    } else {
+      out.push_back(static_cast<char16_t>(c));
+    }
+  }
+}
+
+template <typename T>
+static void FreeExternalString(napi_env /*env*/, void* /*data*/, void* hint) {
+  delete static_cast<T*>(hint);
+}
+
+typedef napi_status (*ExternalLatin1Fn)(napi_env, char*, size_t, napi_finalize,
+                                        void*, napi_value*, bool*);
+typedef napi_status (*ExternalUtf16Fn)(napi_env, char16_t*, size_t, napi_finalize,
+                                       void*, napi_value*, bool*);
+
+struct ExternalStringApi {
+  ExternalLatin1Fn latin1 = nullptr;
+  ExternalUtf16Fn utf16 = nullptr;
+};
+
+static void* FindNodeApiSymbol(const char* name) {
+#ifdef _WIN32
+  return reinterpret_cast<void*>(GetProcAddress(GetModuleHandle(nullptr), name));
+#else
+  return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
+/**
+ * The Node-API 10 external string functions, looked up in the running
+ * process. The addon is built against Node-API 8 headers, so they cannot
+ * be linked directly; both stay null on older runtimes.
+ */
+static const ExternalStringApi& GetExternalStringApi(Napi::Env env) {
+  static const ExternalStringApi api = [&]() {
+    ExternalStringApi found;
+    uint32_t version = 0;
+    if (napi_get_version(env, &version) != napi_ok || version < 10) {
+      return found;
+    }
+    found.latin1 = reinterpret_cast<ExternalLatin1Fn>(
+        FindNodeApiSymbol("node_api_create_external_string_latin1"));
+    found.utf16 = reinterpret_cast<ExternalUtf16Fn>(
+        FindNodeApiSymbol("node_api_create_external_string_utf16"));
+    if (!found.latin1 || !found.utf16) {
+      found = ExternalStringApi();
+    }
+    return found;
+  }();
+  return api;
+}
+
+/**
+ * Create a JS string for a CLOB value. On runtimes with Node-API 10
+ * external strings, values of EXTERNAL_STRING_MIN bytes or more are handed
+ * to V8 without another copy (as Latin-1 if ASCII, otherwise as UTF-16)
+ * and freed by a finalizer. Smaller values, and older runtimes, use
+ * NewTextString().
+ */
+static Napi::String NewLargeTextString(Napi::Env env, std::string& text) {
+  const ExternalStringApi& api = GetExternalStringApi(env);
+  if (text.size() < EXTERNAL_STRING_MIN || !api.latin1) {
+    return NewTextString(env, text.data(), text.size());
+  }
+
+  napi_value value;
+  napi_status status;
+  bool copied = false;
+
+  if (IsAscii(text.data(), text.size())) {
+    std::string* native = new std::string(std::move(text));
+    status = api.latin1(env, &(*native)[0], native->size(),
+                        FreeExternalString<std::string>, native, &value, &copied);
+    if (status != napi_ok) {
+      delete native;
+    }
+  } else {
+    std::u16string* native = new std::u16string();
+    Utf8ToUtf16(text, *native);
+    status = api.utf16(env, &(*native)[0], native->size(),
+                       FreeExternalString<std::u16string>, native, &value, &copied);
+    if (status != napi_ok) {
+      delete native;
+    }
+  }
+  // When V8 copies instead, it has already run the finalizer
+  NAPI_THROW_IF_FAILED(env, status, Napi::String());
+  return Napi::String(env, value);
+}
+
+/**
+ * { preview, totalSize } for a LOB read in preview mode.
+ */
+static Napi::Object MakeLobPreview(Napi::Env env, Napi::Value preview, size_t totalSize) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("preview", preview);
+  result.Set("totalSize", Napi::Number::New(env, static_cast<double>(totalSize)));
+  return result;
+}
+
+/**
+ * Read only the first `limit` bytes of a BLOB. The rest of the LOB is
+ * never transferred.
+ */
+static Napi::Value ReadBlobPreview(Napi::Env env, MimerStatement stmt, int col,
+                                   size_t limit, size_t* bytes) {
+  size_t lobSize;
+  MimerLob lobHandle;
+  int rc = MimerGetLob(stmt, static_cast<int16_t>(col), &lobSize, &lobHandle);
+  if (rc != 0) {
+    return Napi::Value();
+  }
+
+  size_t length = lobSize < limit ? lobSize : limit;
+  Napi::Buffer<uint8_t> preview = Napi::Buffer<uint8_t>::New(env, length);
+  size_t offset = 0;
+  while (offset < length) {
+    size_t chunk = length - offset < LOB_READ_CHUNK ? length - offset : LOB_READ_CHUNK;
+    rc = MimerGetBlobData(&lobHandle, preview.Data() + offset, chunk);
+    if (rc < 0) {
+      return Napi::Value();
+    }
+    offset += chunk;
+  }
+  if (bytes) *bytes += length;
+  return MakeLobPreview(env, preview, lobSize);
+}
+
+/**
+ * Read only the first `limit` characters of a CLOB/NCLOB. Reads stop as
+ * soon as enough characters have arrived.
+ */
+static Napi::Value ReadNclobPreview(Napi::Env env, MimerStatement stmt, int col,
+                                    size_t limit, size_t* bytes) {
+  size_t charCount;
+  MimerLob lobHandle;
+  int rc = MimerGetLob(stmt, static_cast<int16_t>(col), &charCount, &lobHandle);
+  if (rc != 0) {
+    return Napi::Value();
+  }
+
+  std::string text;
+  if (charCount > 0) {
+    // Up to 4 UTF-8 bytes per character, plus the terminator
+    size_t bufSize = limit < LOB_READ_CHUNK / 4 ? limit * 4 + 1 : LOB_READ_CHUNK + 1;
+    std::vector<char> chunkBuf(bufSize);
+    size_t chars = 0;
+    do {
+      rc = MimerGetNclobData8(&lobHandle, chunkBuf.data(), bufSize);
+      if (rc < 0) {
+        return Napi::Value();
+      }
+      size_t len = std::strlen(chunkBuf.data());
+      text.append(chunkBuf.data(), len);
+      chars += Utf8CharCount(chunkBuf.data(), len);
+    } while (rc > 0 && chars < limit);
+    text.resize(Utf8PrefixLength(text.data(), text.size(), limit));
+  }
+  if (bytes) *bytes += text.size();
+  return MakeLobPreview(env, NewTextString(env, text.data(), text.size()), charCount);
+}
+
+/**
+ * Read one column of the current row as a JS value. Returns an empty
+ * Napi::Value if the value could not be read.
+ */
+static Napi::Value DecodeColumnValue(Napi::Env env, MimerStatement stmt,
+                                     int col, int colType, size_t* bytes,
+                                     FetchContext* context) {
+  StringInterner* interner = context ? context->interner.get() : nullptr;
+  const LobPreview* preview = context ? &context->lobPreview : nullptr;
+  int rc;
+
+  // Check if NULL
+  if (MimerIsNull(stmt, static_cast<int16_t>(col)) > 0) {
+    if (bytes) *bytes += sizeof(double);
+    return env.Null();
+  }
+
+  // Get value based on type
+  if (MimerIsInt32(colType)) {
+    int32_t value;
+    rc = MimerGetInt32(stmt, static_cast<int16_t>(col), &value);
+    if (rc == 0) {
+      if (bytes) *bytes += sizeof(double);
+      return Napi::Number::New(env, value);
+    }
+  } else if (MimerIsInt64(colType)) {
+    int64_t value;
+    rc = MimerGetInt64(stmt, static_cast<int16_t>(col), &value);
+    if (rc == 0) {
+      if (bytes) *bytes += sizeof(double);
+      return Napi::Number::New(env, static_cast<double>(value));
+    }
+  } else if (MimerIsDouble(colType)) {
+    double value;
+    rc = MimerGetDouble(stmt, static_cast<int16_t>(col), &value);
+    if (rc == 0) {
+      if (bytes) *bytes += sizeof(double);
+      return Napi::Number::New(env, value);
+    }
+  } else if (MimerIsFloat(colType)) {
+    float value;
+    rc = MimerGetFloat(stmt, static_cast<int16_t>(col), &value);
+    if (rc == 0) {
+      if (bytes) *bytes += sizeof(double);
+      return Napi::Number::New(env, value);
+    }
+  } else if (MimerIsBoolean(colType)) {
+    int32_t value = MimerGetBoolean(stmt, static_cast<int16_t>(col));
+    if (bytes) *bytes += sizeof(double);
+    return Napi::Boolean::New(env, value > 0);
+  } else if (MimerIsBlob(colType) && preview && preview->bytes > 0) {
+    return ReadBlobPreview(env, stmt, col, preview->bytes, bytes);
+  } else if (MimerIsNclob(colType) && preview && preview->chars > 0) {
+    return ReadNclobPreview(env, stmt, col, preview->chars, bytes);
+  } else if (MimerIsBlob(colType)) {
+    // BLOB → Buffer via LOB API, read in chunks
+    size_t lobSize;
+    MimerLob lobHandle;
+    rc = MimerGetLob(stmt, static_cast<int16_t>(col), &lobSize, &lobHandle);
+    if (rc == 0 && lobSize > 0) {
+      uint8_t* buf = new uint8_t[lobSize];
+      size_t offset = 0;
+      size_t remaining = lobSize;
+      while (remaining > 0) {
+        size_t chunk = remaining < LOB_READ_CHUNK ? remaining : LOB_READ_CHUNK;
+        rc = MimerGetBlobData(&lobHandle, buf + offset, chunk);
+        if (rc < 0) break;
+        offset += chunk;
+        remaining -= chunk;
+      }
+      Napi::Value value;
+      if (rc >= 0) {
+        value = Napi::Buffer<uint8_t>::Copy(env, buf, lobSize);
+        if (bytes) *bytes += lobSize;
+      }
+      delete[] buf;
+      return value;
+    } else if (rc == 0) {
+      return Napi::Buffer<uint8_t>::New(env, 0);
+    }
+  } else if (MimerIsNclob(colType)) {
+    // CLOB/NCLOB → String via LOB API, read in chunks
+    size_t charCount;
+    MimerLob lobHandle;
+    rc = MimerGetLob(stmt, static_cast<int16_t>(col), &charCount, &lobHandle);
+    if (rc == 0 && charCount > 0) {
+      std::string result;
+      result.reserve(charCount); // at least charCount bytes
+      char chunkBuf[LOB_READ_CHUNK + 1];
+      do {
+        rc = MimerGetNclobData8(&lobHandle, chunkBuf, sizeof(chunkBuf));
+        if (rc < 0) break;
+        result.append(chunkBuf);
+      } while (rc > 0);
+      if (rc >= 0) {
+        if (bytes) *bytes += result.size();
+        return NewLargeTextString(env, result);
+      }
+    } else if (rc == 0) {
+      return Napi::String::New(env, "");
+    }
+  } else if (MimerIsBinary(colType)) {
+    int32_t size = MimerGetBinary(stmt, static_cast<int16_t>(col), nullptr, 0);
+    if (size > 0) {
+      uint8_t* buffer = new uint8_t[size];
+      rc = MimerGetBinary(stmt, static_cast<int16_t>(col), buffer, size);
+      Napi::Value value;
+      if (rc >= 0) {
+        value = Napi::Buffer<uint8_t>::Copy(env, buffer, size);
+        if (bytes) *bytes += size;
+      }
+      delete[] buffer;
+      return value;
+    }
+    return Napi::Buffer<uint8_t>::New(env, 0);
+  } else {
+    // Default: try as string (covers VARCHAR, DATE, TIME, TIMESTAMP, DECIMAL, UUID, etc.)
+    // Use a single buffer that fits most values on the first call.
+    // Only retry with the exact size if the value was truncated.
+    char buf[256];
+    int32_t size = MimerGetString8(stmt, static_cast<int16_t>(col), buf, sizeof(buf));
+    if (size > 0 && size < static_cast<int32_t>(sizeof(buf))) {
+      if (bytes) *bytes += size;
+      if (interner && interner->Active(col - 1)) {
+        return interner->Get(env, col - 1, buf, static_cast<size_t>(size));
+      }
+      return NewTextString(env, buf, static_cast<size_t>(size));
+    } else if (size >= static_cast<int32_t>(sizeof(buf))) {
+      char* buffer = new char[size + 1];
+      rc = MimerGetString8(stmt, static_cast<int16_t>(col), buffer, size + 1);
+      Napi::Value value;
+      if (rc >= 0) {
+        value = NewTextString(env, buffer, static_cast<size_t>(size));
+        if (bytes) *bytes += size;
+      }
+      delete[] buffer;
+      return value;
+    }
+    return Napi::String::New(env, "");
+  }
+
+  return Napi::Value();
+}
+
+/**
+ * DecodeColumnValue(), counting the cell in context->stats when set.
+ */
+static Napi::Value ReadColumnValue(Napi::Env env, MimerStatement stmt,
+                                   int col, int colType, size_t* bytes,
+                                   FetchContext* context) {
+  OperationStats* stats = context ? context->stats : nullptr;
+  if (!stats) {
+    return DecodeColumnValue(env, stmt, col, colType, bytes, context);
+  }
+  size_t size = 0;
+  Napi::Value value = DecodeColumnValue(env, stmt, col, colType, &size, context);
+  if (bytes) *bytes += size;
+  if (!value.IsEmpty()) {
+    stats->CountCell(colType, value.IsNull(), size);
+  }
+  return value;
+}
+
+/**
+ * Queue a non-NULL BINARY/VARBINARY value in `slab`. Returns false if the
+ * value could not be read.
+ */
+static bool ReadBinaryIntoSlab(MimerStatement stmt, int col, ByteSlab& slab,
+                               Napi::Object row, Napi::Value key,
+                               size_t* bytes) {
+  uint8_t small[64];
+  int32_t size = MimerGetBinary(stmt, static_cast<int16_t>(col), nullptr, 0);
+  if (size < 0) {
+    return false;
+  }
+  if (static_cast<size_t>(size) <= sizeof(small)) {
+    if (size > 0 && MimerGetBinary(stmt, static_cast<int16_t>(col), small, size) < 0) {
+      return false;
+    }
+    slab.Add(row, key, small, static_cast<size_t>(size));
+  } else {
+    std::vector<uint8_t> buffer(size);
+    if (MimerGetBinary(stmt, static_cast<int16_t>(col), buffer.data(), size) < 0) {
+      return false;
+    }
+    slab.Add(row, key, buffer.data(), buffer.size());
+  }
+  if (bytes) *bytes += size;
+  return true;
+}
+
+/**
+ * Read a non-NULL character value as UTF-8 bytes. Returns false if the
+ * value could not be read.
+ */
+static bool ReadTextBytes(MimerStatement stmt, int col, std::string& out) {
+  char buf[256];
+  int32_t size = MimerGetString8(stmt, static_cast<int16_t>(col), buf, sizeof(buf));
+  if (size < 0) {
+    return false;
+  }
+  if (size < static_cast<int32_t>(sizeof(buf))) {
+    out.assign(buf, size);
+    return true;
+  }
+  out.resize(size + 1);
+  if (MimerGetString8(stmt, static_cast<int16_t>(col), &out[0], size + 1) < 0) {
+    return false;
+  }
+  out.resize(size);
+  return true;
+}
+
 /**
  * Fetch a single row from an open cursor into a JS object.
  * Assumes MimerFetch() has already returned MIMER_SUCCESS.
  */
 Napi::Object FetchSingleRow(Napi::Env env, MimerStatement stmt, int columnCount,
                              const std::vector<std::string>& colNames,
-                             const std::vector<int>& colTypes) {
-  Napi::Object row = Napi::Object::New(env);
+                             const std::vector<int>& colTypes,
+                             size_t* bytes, FetchContext* context) {
+  Napi::Object row = context && !context->rowFactory.IsEmpty()
+      ? context->rowFactory.New({})
+      : Napi::Object::New(env);
+  FillRow(env, stmt, columnCount, colNames, colTypes, row, false, bytes, context);
+  return row;
+}
+
+/**
+ * Decode column `col` of the current row into `target[key]`, applying the
+ * rawText, binarySlab and other context options.
+ */
+static void SetColumn(Napi::Env env, MimerStatement stmt, int col, int colType,
+                      Napi::Object target, Napi::Value key, bool overwrite,
+                      size_t* bytes, FetchContext* context, std::string& text) {
+  ByteSlab* slab = context ? context->slab.get() : nullptr;
+  OperationStats* stats = context ? context->stats : nullptr;
+
+  if (context && !context->rawText.empty() && context->rawText[col - 1] &&
+      MimerIsNull(stmt, static_cast<int16_t>(col)) <= 0 &&
+      ReadTextBytes(stmt, col, text)) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+    if (bytes) *bytes += text.size();
+    if (stats) {
+      // A character cell, produced as a Buffer
+      stats->Count(STAT_CELLS_STRING);
+      stats->Count(STAT_BUFFER_BYTES, text.size());
+    }
+    if (slab) {
+      slab->Add(target, key, data, text.size());
+      target.Set(key, env.Null());
+    } else {
+      target.Set(key, Napi::Buffer<uint8_t>::Copy(env, data, text.size()));
+    }
+    return;
+  }
+
+  size_t slabBytes = 0;
+  if (slab && MimerIsBinary(colType) &&
+      MimerIsNull(stmt, static_cast<int16_t>(col)) <= 0 &&
+      ReadBinaryIntoSlab(stmt, col, *slab, target, key, &slabBytes)) {
+    if (bytes) *bytes += slabBytes;
+    if (stats) {
+      stats->CountCell(colType, false, slabBytes);
+    }
+    // Placeholder keeps the property order; Flush() sets the view
+    target.Set(key, env.Null());
+    return;
+  }
+
+  Napi::Value value = ReadColumnValue(env, stmt, col, colType, bytes, context);
+  if (!value.IsEmpty()) {
+    target.Set(key, value);
+  } else if (overwrite) {
+    // Do not leave the previous row's value behind
+    target.Set(key, env.Undefined());
+  }
+}
+
+/**
+ * Write the current row's values into an existing object.
+ */
+void FillRow(Napi::Env env, MimerStatement stmt, int columnCount,
+             const std::vector<std::string>& colNames,
+             const std::vector<int>& colTypes,
+             Napi::Object row, bool overwrite, size_t* bytes,
+             FetchContext* context) {
+  std::string text;
+  for (int col = 1; col <= columnCount; col++) {
+    Napi::Value key = context ? context->keys[col - 1]
+                              : Napi::String::New(env, colNames[col - 1]);
+    SetColumn(env, stmt, col, colTypes[col - 1], row, key, overwrite,
+              bytes, context, text);
+  }
+}
+
+/**
+ * Fetch all result rows from an open cursor into a JS array of objects.
+ */
+Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount) {
+  std::vector<std::string> colNames;
+  std::vector<int> colTypes;
+  CacheColumnMetadata(stmt, columnCount, colNames, colTypes);
+  return FetchResults(env, stmt, columnCount, colNames, colTypes);
+}
+
+Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes) {
+  return FetchResults(env, stmt, columnCount, colNames, colTypes,
+                      FetchLimits(), nullptr);
+}
+
+/**
+ * Stop at a fetch limit: throw, or flag the result as truncated.
+ */
+void ReportFetchLimit(Napi::Env env, const FetchLimits& limits,
+                      const char* limit, uint64_t value, bool* truncated) {
+  if (limits.throwOnLimit) {
+    std::ostringstream oss;
+    oss << "Result exceeds " << limit << " (" << value << ")";
+    Napi::Error error = Napi::Error::New(env, oss.str());
+    error.Set("limit", Napi::String::New(env, limit));
+    error.ThrowAsJavaScriptException();
+  } else if (truncated) {
+    *truncated = true;
+  }
+}
+
+Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes,
+                         const FetchLimits& limits, bool* truncated,
+                         FetchContext* context) {
+  Napi::Array rows = Napi::Array::New(env);
+  uint32_t rowIndex = 0;
+  size_t bytes = 0;
+  PhaseTiming* timing = context ? context->timing : nullptr;
+  size_t* bytesPtr = limits.maxBytes > 0 || timing ? &bytes : nullptr;
+
+  while (MimerFetch(stmt) == MIMER_SUCCESS) {
+    if (timing) {
+      timing->Lap(timing->fetch);
+    }
+    // A row past maxRows exists, so the result is incomplete
+    if (limits.maxRows > 0 && rowIndex >= limits.maxRows) {
+      ReportFetchLimit(env, limits, "maxRows", limits.maxRows, truncated);
+      break;
+    }
+    Napi::Object row = FetchSingleRow(env, stmt, columnCount, colNames, colTypes,
+                                      bytesPtr, context);
+    if (limits.maxBytes > 0 && bytes > limits.maxBytes) {
+      ReportFetchLimit(env, limits, "maxBytes", limits.maxBytes, truncated);
+      break;
+    }
+    rows.Set(rowIndex++, row);
+    if (timing) {
+      timing->Lap(timing->convert);
+    }
+  }
+  if (timing) {
+    // The last MimerFetch() call, which found no more rows
+    timing->Lap(timing->fetch);
+  }
+
+  if (context && context->slab && !env.IsExceptionPending()) {
+    context->slab->Flush();
+  }
+  if (timing) {
+    timing->Lap(timing->convert);
+    timing->rows = rowIndex;
+    timing->bytes = bytes;
+  }
+  if (context && context->stats) {
+    context->stats->Count(STAT_ROWS_FETCHED, rowIndex);
+  }
+  return rows;
+}
+
+/**
+ * Byte string that identifies a decoded JS value, for grouping rows.
+ */
+static std::string ValueKey(Napi::Value value) {
+  std::string key;
+  if (value.IsNumber()) {
+    double d = value.As<Napi::Number>().DoubleValue();
+    key.assign("n");
+    key.append(reinterpret_cast<const char*>(&d), sizeof(d));
+  } else if (value.IsString()) {
+    key.assign("s");
+    key.append(value.As<Napi::String>().Utf8Value());
+  } else if (value.IsBoolean()) {
+    key.assign(value.As<Napi::Boolean>().Value() ? "t" : "f");
+  } else if (value.IsTypedArray()) {
+    Napi::Uint8Array bytes = value.As<Napi::Uint8Array>();
+    key.assign("x");
+    key.append(reinterpret_cast<const char*>(bytes.Data()), bytes.ByteLength());
+  } else if (value.IsNull() || value.IsUndefined()) {
+    key.assign("z");
+  } else {
+    key.assign("o");
+    key.append(value.ToString().Utf8Value());
+  }
+  return key;
+}
+
+/**
+ * 0-based index of `name` in the result columns, or -1 after throwing.
+ */
+static int RequireColumn(Napi::Env env, const std::vector<std::string>& colNames,
+                         const std::string& name, const char* option) {
+  for (size_t i = 0; i < colNames.size(); i++) {
+    if (colNames[i] == name) {
+      return static_cast<int>(i);
+    }
+  }
+  Napi::Error::New(env, std::string(option) + " column '" + name +
+                   "' is not in the result")
+      .ThrowAsJavaScriptException();
+  return -1;
+}
+
+Napi::Value FetchShaped(Napi::Env env, MimerStatement stmt, int columnCount,
+                        const std::vector<std::string>& colNames,
+                        const std::vector<int>& colTypes,
+                        const FetchLimits& limits, bool* truncated,
+                        FetchContext* context, const DecodeOptions& decode,
+                        size_t* rowCount) {
+  bool nested = !decode.nest.parentKey.empty();
+  int keyCol = RequireColumn(env, colNames,
+                             nested ? decode.nest.parentKey : decode.keyBy,
+                             nested ? "nest.parentKey" : "keyBy");
+  if (keyCol < 0) {
+    return env.Undefined();
+  }
+  // Slab values are only set by ByteSlab::Flush(), after the Map is built
+  if (!nested && context->slab &&
+      (MimerIsBinary(colTypes[keyCol]) ||
+       (!context->rawText.empty() && context->rawText[keyCol]))) {
+    Napi::Error::New(env, "keyBy column '" + decode.keyBy +
+                     "' cannot be decoded with binarySlab")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // nest: which columns belong to the child objects
+  std::vector<bool> isChild(columnCount, false);
+  for (const std::string& name : decode.nest.childColumns) {
+    int col = RequireColumn(env, colNames, name, "nest.childColumns");
+    if (col < 0) {
+      return env.Undefined();
+    }
+    isChild[col] = true;
+  }
+
+  Napi::Object map;
+  Napi::Function mapSet;
+  Napi::Array parents;
+  Napi::Value childrenKey;
+  struct Group {
+    Napi::Array children;
+    uint32_t count;
+  };
+  std::unordered_map<std::string, Group> groups;
+
+  if (nested) {
+    parents = Napi::Array::New(env);
+    childrenKey = Napi::String::New(env, decode.nest.as);
+  } else {
+    map = env.Global().Get("Map").As<Napi::Function>().New({});
+    mapSet = map.Get("set").As<Napi::Function>();
+  }
+
+  uint32_t rows = 0;
+  size_t bytes = 0;
+  PhaseTiming* timing = context->timing;
+  size_t* bytesPtr = limits.maxBytes > 0 || timing ? &bytes : nullptr;
+  std::string text;
+
+  while (MimerFetch(stmt) == MIMER_SUCCESS) {
+    if (timing) {
+      timing->Lap(timing->fetch);
+    }
+    if (limits.maxRows > 0 && rows >= limits.maxRows) {
+      ReportFetchLimit(env, limits, "maxRows", limits.maxRows, truncated);
+      break;
+    }
+
+    if (!nested) {
+      Napi::Object row = FetchSingleRow(env, stmt, columnCount, colNames, colTypes,
+                                        bytesPtr, context);
+      if (limits.maxBytes > 0 && bytes > limits.maxBytes) {
+        ReportFetchLimit(env, limits, "maxBytes", limits.maxBytes, truncated);
+        break;
+      }
+      mapSet.Call(map, {row.Get(context->keys[keyCol]), row});
+      rows++;
+      if (timing) {
+        timing->Lap(timing->convert);
+      }
+      continue;
+    }
+
+    // Decode the key first to find (or start) the parent
+    Napi::Value key = ReadColumnValue(env, stmt, keyCol + 1, colTypes[keyCol],
+                                      bytesPtr, context);
+    if (key.IsEmpty()) {
+      key = env.Null();
+    }
+    std::string groupKey = ValueKey(key);
+    auto it = groups.find(groupKey);
+    if (it == groups.end()) {
+      Napi::Object parent = context && !context->rowFactory.IsEmpty()
+          ? context->rowFactory.New({})
+          : Napi::Object::New(env);
+      for (int col = 1; col <= columnCount; col++) {
+        if (isChild[col - 1]) {
+          continue;
+        }
+        if (col - 1 == keyCol) {
+          parent.Set(context->keys[keyCol], key);
+        } else {
+          SetColumn(env, stmt, col, colTypes[col - 1], parent,
+                    context->keys[col - 1], false, bytesPtr, context, text);
+        }
+      }
+      Napi::Array children = Napi::Array::New(env);
+      parent.Set(childrenKey, children);
+      parents.Set(parents.Length(), parent);
+      it = groups.emplace(std::move(groupKey), Group{children, 0}).first;
+    }
+
+    Napi::Object child = Napi::Object::New(env);
+    for (int col = 1; col <= columnCount; col++) {
+      if (isChild[col - 1]) {
+        SetColumn(env, stmt, col, colTypes[col - 1], child,
+                  context->keys[col - 1], false, bytesPtr, context, text);
+      }
+    }
+    if (limits.maxBytes > 0 && bytes > limits.maxBytes) {
+      ReportFetchLimit(env, limits, "maxBytes", limits.maxBytes, truncated);
+      break;
+    }
+    it->second.children.Set(it->second.count++, child);
+    rows++;
+    if (timing) {
+      timing->Lap(timing->convert);
+    }
+  }
+  if (timing) {
+    timing->Lap(timing->fetch);
+  }
+
+  if (context->slab && !env.IsExceptionPending()) {
+    context->slab->Flush();
+  }
+  if (timing) {
+    timing->Lap(timing->convert);
+    timing->rows = rows;
+    timing->bytes = bytes;
+  }
+  if (context->stats) {
+    context->stats->Count(STAT_ROWS_FETCHED, rows);
+  }
+  *rowCount = rows;
+  if (nested) {
+    return parents;
+  }
+  return map;
+}
+
+/**
+ * Read a limit option as a non-negative safe integer (Number.isSafeInteger).
+ * Leaves value unchanged when the option is undefined or null.
+ */
+static bool ReadLimitOption(Napi::Env env, Napi::Object opts, const char* name,
+                            uint64_t& value) {
+  Napi::Value v = opts.Get(name);
+  if (v.IsUndefined() || v.IsNull()) {
+    return true;
+  }
+  double d = v.IsNumber() ? v.As<Napi::Number>().DoubleValue() : -1;
+  if (!(d >= 0 && d <= 9007199254740991.0 && std::floor(d) == d)) {
+    Napi::TypeError::New(env, std::string(name) + " must be a non-negative safe integer")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  value = static_cast<uint64_t>(d);
+  return true;
+}
+
+bool ParseFetchLimits(Napi::Env env, Napi::Value options, FetchLimits& limits) {
+  if (!options.IsObject()) {
+    return true;
+  }
+  Napi::Object opts = options.As<Napi::Object>();
+
+  if (!ReadLimitOption(env, opts, "maxRows", limits.maxRows)) {
+    return false;
+  }
+
+  uint64_t maxBytes = limits.maxBytes;
+  if (!ReadLimitOption(env, opts, "maxBytes", maxBytes)) {
+    return false;
+  }
+  limits.maxBytes = static_cast<size_t>(maxBytes);
+
+  Napi::Value onLimit = opts.Get("onLimit");
+  if (!onLimit.IsUndefined() && !onLimit.IsNull()) {
+    std::string mode = onLimit.IsString() ? onLimit.As<Napi::String>().Utf8Value() : "";
+    if (mode == "error") {
+      limits.throwOnLimit = true;
+    } else if (mode == "truncate") {
+      limits.throwOnLimit = false;
+    } else {
+      Napi::TypeError::New(env, "onLimit must be 'error' or 'truncate'")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ColumnSelection::Includes(const std::string& name) const {
+  if (all) {
+    return true;
+  }
+  for (const std::string& n : names) {
+    if (n == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Parse `true` or an array of column names into `selection`.
+ */
+static bool ParseColumnSelection(Napi::Env env, Napi::Object opts, const char* option,
+                                 ColumnSelection& selection) {
+  Napi::Value value = opts.Get(option);
+  if (value.IsArray()) {
+    Napi::Array names = value.As<Napi::Array>();
+    for (uint32_t i = 0; i < names.Length(); i++) {
+      Napi::Value name = names.Get(i);
+      if (!name.IsString()) {
+        Napi::TypeError::New(env, std::string(option) +
+                             " must be true or an array of column names")
+            .ThrowAsJavaScriptException();
+        return false;
+      }
+      selection.names.push_back(name.As<Napi::String>().Utf8Value());
+    }
+  } else if (value.IsBoolean()) {
+    selection.all = value.As<Napi::Boolean>().Value();
+  } else if (!value.IsUndefined() && !value.IsNull()) {
+    Napi::TypeError::New(env, std::string(option) +
+                         " must be true or an array of column names")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+bool ParseDecodeOptions(Napi::Env env, Napi::Value options, DecodeOptions& decode) {
+  if (!options.IsObject()) {
+    return true;
+  }
+  Napi::Object opts = options.As<Napi::Object>();
+
+  if (!ParseColumnSelection(env, opts, "intern", decode.intern.columns) ||
+      !ParseColumnSelection(env, opts, "rawText", decode.rawText)) {
+    return false;
+  }
+
+  Napi::Value limit = opts.Get("internLimit");
+  if (!limit.IsUndefined() && !limit.IsNull()) {
+    if (!limit.IsNumber() || limit.As<Napi::Number>().DoubleValue() < 1) {
+      Napi::TypeError::New(env, "internLimit must be a positive number")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    decode.intern.limit = static_cast<size_t>(limit.As<Napi::Number>().DoubleValue());
+  }
+
+  decode.binarySlab = opts.Get("binarySlab").ToBoolean().Value();
+
+  Napi::Value factory = opts.Get("rowFactory");
+  if (!factory.IsUndefined() && !factory.IsNull()) {
+    if (!factory.IsFunction()) {
+      Napi::TypeError::New(env, "rowFactory must be a class or constructor function")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    decode.rowFactory = factory.As<Napi::Function>();
+  }
+
+  Napi::Value fieldMap = opts.Get("fieldMap");
+  if (!fieldMap.IsUndefined() && !fieldMap.IsNull()) {
+    if (!fieldMap.IsObject()) {
+      Napi::TypeError::New(env, "fieldMap must be an object of column: property names")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    decode.fieldMap = fieldMap.As<Napi::Object>();
+  }
+
+  Napi::Value keyBy = opts.Get("keyBy");
+  if (!keyBy.IsUndefined() && !keyBy.IsNull()) {
+    if (!keyBy.IsString()) {
+      Napi::TypeError::New(env, "keyBy must be a column name")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    decode.keyBy = keyBy.As<Napi::String>().Utf8Value();
+  }
+
+  Napi::Value nest = opts.Get("nest");
+  if (!nest.IsUndefined() && !nest.IsNull()) {
+    Napi::Value parentKey = nest.IsObject() ? nest.As<Napi::Object>().Get("parentKey") : nest;
+    Napi::Value childColumns = nest.IsObject() ? nest.As<Napi::Object>().Get("childColumns") : nest;
+    if (!parentKey.IsString() || !childColumns.IsArray()) {
+      Napi::TypeError::New(env, "nest must be { parentKey, childColumns, as }")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    decode.nest.parentKey = parentKey.As<Napi::String>().Utf8Value();
+    Napi::Array children = childColumns.As<Napi::Array>();
+    for (uint32_t i = 0; i < children.Length(); i++) {
+      decode.nest.childColumns.push_back(children.Get(i).ToString().Utf8Value());
+    }
+    Napi::Value as = nest.As<Napi::Object>().Get("as");
+    if (as.IsString()) {
+      decode.nest.as = as.As<Napi::String>().Utf8Value();
+    }
+  }
+
+  if (!decode.keyBy.empty() && !decode.nest.parentKey.empty()) {
+    Napi::TypeError::New(env, "keyBy and nest cannot be combined")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Value preview = opts.Get("lobPreview");
+  if (!preview.IsUndefined() && !preview.IsNull()) {
+    if (!preview.IsObject()) {
+      Napi::TypeError::New(env, "lobPreview must be an object { bytes, chars }")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    Napi::Object p = preview.As<Napi::Object>();
+    const char* keys[] = { "bytes", "chars" };
+    size_t* targets[] = { &decode.lobPreview.bytes, &decode.lobPreview.chars };
+    for (int i = 0; i < 2; i++) {
+      Napi::Value v = p.Get(keys[i]);
+      if (v.IsUndefined() || v.IsNull()) {
+        continue;
+      }
+      if (!v.IsNumber() || v.As<Napi::Number>().DoubleValue() < 1) {
+        Napi::TypeError::New(env, std::string("lobPreview.") + keys[i] +
+                             " must be a positive number")
+            .ThrowAsJavaScriptException();
+        return false;
+      }
+      *targets[i] = static_cast<size_t>(v.As<Napi::Number>().DoubleValue());
+    }
+  }
+  return true;
+}
+
+StringInterner::StringInterner(const std::vector<std::string>& colNames,
+                               const InternOptions& options)
+  : columns_(colNames.size()), limit_(options.limit) {
+  for (size_t i = 0; i < colNames.size(); i++) {
+    columns_[i].active = options.columns.Includes(colNames[i]);
+  }
+}
+
+Napi::Value StringInterner::Get(Napi::Env env, int col,
+                                const char* data, size_t length) {
+  Column& column = columns_[col];
+  std::string key(data, length);
+
+  auto it = column.values.find(key);
+  if (it != column.values.end()) {
+    return it->second;
+  }
+
+  Napi::Value str = NewTextString(env, data, length);
+  if (column.values.size() >= limit_) {
+    // Too many distinct values to be worth it; stop interning this column
+    column.active = false;
+    column.values.clear();
+    return str;
+  }
+  column.values.emplace(std::move(key), str);
+  return str;
+}
+
+void ByteSlab::Add(Napi::Object row, Napi::Value key,
+                   const uint8_t* data, size_t length) {
+  if (!data_.empty() && data_.size() + length > BYTE_SLAB_SIZE) {
+    Flush();
+  }
+  size_t offset = data_.size();
+  data_.insert(data_.end(), data, data + length);
+  pending_.push_back({row, key, offset, length});
+}
+
+void ByteSlab::Flush() {
+  if (pending_.empty()) {
+    return;
+  }
+  Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env_, data_.size());
+  if (!data_.empty()) {
+    std::memcpy(buffer.Data(), data_.data(), data_.size());
+  }
+  for (const Pending& p : pending_) {
+    p.row.Set(p.key, Napi::Uint8Array::New(env_, p.length, buffer, p.offset));
+  }
+  data_.clear();
+  pending_.clear();
+}
+
+void PhaseTiming::Add(const PhaseTiming& other) {
+  prepare += other.prepare;
+  bind += other.bind;
+  execute += other.execute;
+  fetch += other.fetch;
+  convert += other.convert;
+  rows += other.rows;
+  bytes += other.bytes;
+  statements++;
+}
+
+Napi::Object PhaseTiming::ToObject(Napi::Env env) const {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("prepare", Napi::Number::New(env, prepare));
+  obj.Set("bind", Napi::Number::New(env, bind));
+  obj.Set("execute", Napi::Number::New(env, execute));
+  obj.Set("fetch", Napi::Number::New(env, fetch));
+  obj.Set("convert", Napi::Number::New(env, convert));
+  obj.Set("total", Napi::Number::New(env, prepare + bind + execute + fetch + convert));
+  obj.Set("rows", Napi::Number::New(env, static_cast<double>(rows)));
+  obj.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes)));
+  return obj;
+}
+
+void ParseTiming(Napi::Value options, bool& enabled) {
+  if (!options.IsObject()) {
+    return;
+  }
+  Napi::Value value = options.As<Napi::Object>().Get("timing");
+  if (!value.IsUndefined()) {
+    enabled = value.ToBoolean().Value();
+  }
+}
+
+FetchContext::FetchContext(Napi::Env env, const std::vector<std::string>& colNames,
+                           const std::vector<int>& colTypes,
+                           const DecodeOptions& options) {
+  if (!options.intern.columns.Empty()) {
+    interner.reset(new StringInterner(colNames, options.intern));
+  }
+  if (options.binarySlab) {
+    slab.reset(new ByteSlab(env));
+  }
+  lobPreview = options.lobPreview;
+  rowFactory = options.rowFactory;
+
+  keys.reserve(colNames.size());
+  for (const std::string& name : colNames) {
+    Napi::Value mapped = options.fieldMap.IsEmpty()
+        ? Napi::Value() : options.fieldMap.Get(name);
+    keys.push_back(!mapped.IsEmpty() && mapped.IsString()
+        ? mapped : Napi::String::New(env, name));
+  }
+  if (!options.rawText.Empty()) {
+    rawText.resize(colNames.size());
+    for (size_t i = 0; i < colNames.size(); i++) {
+      rawText[i] = IsCharacterType(colTypes[i]) && options.rawText.Includes(colNames[i]);
+    }
+  }
+}
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr uint64_t FNV_PRIME        = 1099511628211ULL;
+
+static inline uint64_t FnvAppend(uint64_t h, const void* data, size_t len) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+static inline uint64_t FnvAppendTagged(uint64_t h, char tag,
+                                       const void* data, size_t len) {
+  h = FnvAppend(h, &tag, 1);
+  uint64_t n = len;
+  h = FnvAppend(h, &n, sizeof(n));
+  return FnvAppend(h, data, len);
+}
+
+/**
+ * Hash a JS parameter array. Type tags keep values of different JS types
+ * apart; length prefixes keep ['ab', 'c'] apart from ['a', 'bc'].
+ */
+uint64_t HashParameters(Napi::Array params) {
+  uint64_t h = FNV_OFFSET_BASIS;
+  uint32_t count = params.Length();
+
+  for (uint32_t i = 0; i < count; i++) {
+    Napi::Value val = params[i];
+
+    if (val.IsNull() || val.IsUndefined()) {
+      h = FnvAppendTagged(h, 'z', nullptr, 0);
+    } else if (val.IsBoolean()) {
+      char b = val.As<Napi::Boolean>().Value() ? 1 : 0;
+      h = FnvAppendTagged(h, 'b', &b, 1);
+    } else if (val.IsNumber()) {
+      double num = val.As<Napi::Number>().DoubleValue();
+      if (num == 0) num = 0;  // fold -0 into +0
+      h = FnvAppendTagged(h, 'n', &num, sizeof(num));
+    } else if (val.IsString()) {
+      std::string str = val.As<Napi::String>().Utf8Value();
+      h = FnvAppendTagged(h, 's', str.data(), str.size());
+    } else if (val.IsBuffer()) {
+      Napi::Buffer<uint8_t> buf = val.As<Napi::Buffer<uint8_t>>();
+      h = FnvAppendTagged(h, 'x', buf.Data(), buf.Length());
+    } else {
+      // Mirrors BindParameters(): anything else is bound as its string form
+      std::string str = val.ToString().Utf8Value();
+      h = FnvAppendTagged(h, 's', str.data(), str.size());
+    }
+  }
+
+  return h;
+}
+
+Napi::Value HashParams(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  uint64_t h = FNV_OFFSET_BASIS;
+  if (info.Length() >= 1 && info[0].IsArray()) {
+    h = HashParameters(info[0].As<Napi::Array>());
+  }
+
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+  return Napi::String::New(env, hex, 16);
+}
+
+/**
+ * Read the current row into native cells. Mirrors the type dispatch in
+ * FetchSingleRow(); values that fail to read are left as Null.
+ */
+void ReadRawRow(MimerStatement stmt, int columnCount,
+                const std::vector<int>& colTypes,
+                std::vector<RawCell>& cells) {
+  cells.resize(columnCount);
   int rc;
 
   for (int col = 1; col <= columnCount; col++) {
-    const char* colName = colNames[col - 1].c_str();
+    RawCell& cell = cells[col - 1];
     int colType = colTypes[col - 1];
+    int16_t idx = static_cast<int16_t>(col);
+
+    cell.kind = RawCell::Null;
+    cell.bytes.clear();
 
-    // Check if NULL
-    if (MimerIsNull(stmt, static_cast<int16_t>(col)) > 0) {
-      row.Set(colName, env.Null());
+    if (MimerIsNull(stmt, idx) > 0) {
       continue;
     }
 
-    // Get value based on type
     if (MimerIsInt32(colType)) {
       int32_t value;
-      rc = MimerGetInt32(stmt, static_cast<int16_t>(col), &value);
-      if (rc == 0) {
-        row.Set(colName, Napi::Number::New(env, value));
+      if (MimerGetInt32(stmt, idx, &value) == 0) {
+        cell.kind = RawCell::Int;
+        cell.i = value;
       }
     } else if (MimerIsInt64(colType)) {
       int64_t value;
-      rc = MimerGetInt64(stmt, static_cast<int16_t>(col), &value);
-      if (rc == 0) {
-        row.Set(colName, Napi::Number::New(env, static_cast<double>(value)));
+      if (MimerGetInt64(stmt, idx, &value) == 0) {
+        cell.kind = RawCell::Int;
+        cell.i = value;
       }
     } else if (MimerIsDouble(colType)) {
       double value;
-      rc = MimerGetDouble(stmt, static_cast<int16_t>(col), &value);
-      if (rc == 0) {
-        row.Set(colName, Napi::Number::New(env, value));
+      if (MimerGetDouble(stmt, idx, &value) == 0) {
+        cell.kind = RawCell::Double;
+        cell.d = value;
       }
     } else if (MimerIsFloat(colType)) {
       float value;
-      rc = MimerGetFloat(stmt, static_cast<int16_t>(col), &value);
-      if (rc == 0) {
-        row.Set(colName, Napi::Number::New(env, value));
+      if (MimerGetFloat(stmt, idx, &value) == 0) {
+        cell.kind = RawCell::Double;
+        cell.d = value;
       }
     } else if (MimerIsBoolean(colType)) {
-      int32_t value = MimerGetBoolean(stmt, static_cast<int16_t>(col));
-      row.Set(colName, Napi::Boolean::New(env, value > 0));
+      cell.kind = RawCell::Bool;
+      cell.i = MimerGetBoolean(stmt, idx) > 0 ? 1 : 0;
     } else if (MimerIsBlob(colType)) {
-      // BLOB → Buffer via LOB API, read in chunks
       size_t lobSize;
       MimerLob lobHandle;
-      rc = MimerGetLob(stmt, static_cast<int16_t>(col), &lobSize, &lobHandle);
-      if (rc == 0 && lobSize > 0) {
-        uint8_t* buf = new uint8_t[lobSize];
+      rc = MimerGetLob(stmt, idx, &lobSize, &lobHandle);
+      if (rc == 0) {
+        cell.bytes.resize(lobSize);
         size_t offset = 0;
         size_t remaining = lobSize;
         while (remaining > 0) {
           size_t chunk = remaining < LOB_READ_CHUNK ? remaining : LOB_READ_CHUNK;
-          rc = MimerGetBlobData(&lobHandle, buf + offset, chunk);
+          rc = MimerGetBlobData(&lobHandle, &cell.bytes[offset], chunk);
           if (rc < 0) break;
           offset += chunk;
           remaining -= chunk;
         }
         if (rc >= 0) {
-          row.Set(colName, Napi::Buffer<uint8_t>::Copy(env, buf, lobSize));
+          cell.kind = RawCell::Binary;
         }
-        delete[] buf;
-      } else if (rc == 0) {
-        row.Set(colName, Napi::Buffer<uint8_t>::New(env, 0));
       }
     } else if (MimerIsNclob(colType)) {
-      // CLOB/NCLOB → String via LOB API, read in chunks
       size_t charCount;
       MimerLob lobHandle;
-      rc = MimerGetLob(stmt, static_cast<int16_t>(col), &charCount, &lobHandle);
+      rc = MimerGetLob(stmt, idx, &charCount, &lobHandle);
       if (rc == 0 && charCount > 0) {
-        std::string result;
-        result.reserve(charCount); // at least charCount bytes
+        cell.bytes.reserve(charCount);
         char chunkBuf[LOB_READ_CHUNK + 1];
         do {
           rc = MimerGetNclobData8(&lobHandle, chunkBuf, sizeof(chunkBuf));
           if (rc < 0) break;
-          result.append(chunkBuf);
+          cell.bytes.append(chunkBuf);
         } while (rc > 0);
-        if (rc >= 0) {
-          row.Set(colName, Napi::String::New(env, result));
-        }
-      } else if (rc == 0) {
-        row.Set(colName, Napi::String::New(env, ""));
+      }
+      if (rc >= 0) {
+        cell.kind = RawCell::String;
       }
     } else if (MimerIsBinary(colType)) {
-      int32_t size = MimerGetBinary(stmt, static_cast<int16_t>(col), nullptr, 0);
+      int32_t size = MimerGetBinary(stmt, idx, nullptr, 0);
+      cell.kind = RawCell::Binary;
       if (size > 0) {
-        uint8_t* buffer = new uint8_t[size];
-        rc = MimerGetBinary(stmt, static_cast<int16_t>(col), buffer, size);
-        if (rc >= 0) {
-          row.Set(colName, Napi::Buffer<uint8_t>::Copy(env, buffer, size));
+        cell.bytes.resize(size);
+        rc = MimerGetBinary(stmt, idx, &cell.bytes[0], size);
+        if (rc < 0) {
+          cell.kind = RawCell::Null;
+          cell.bytes.clear();
         }
-        delete[] buffer;
-      } else {
-        row.Set(colName, Napi::Buffer<uint8_t>::New(env, 0));
       }
     } else {
-      // Default: try as string (covers VARCHAR, DATE, TIME, TIMESTAMP, DECIMAL, UUID, etc.)
-      // Use a single buffer that fits most values on the first call.
-      // Only retry with the exact size if the value was truncated.
       char buf[256];
-      int32_t size = MimerGetString8(stmt, static_cast<int16_t>(col), buf, sizeof(buf));
+      int32_t size = MimerGetString8(stmt, idx, buf, sizeof(buf));
+      cell.kind = RawCell::String;
       if (size > 0 && size < static_cast<int32_t>(sizeof(buf))) {
-        row.Set(colName, Napi::String::New(env, buf));
+        cell.bytes.assign(buf, size);
       } else if (size >= static_cast<int32_t>(sizeof(buf))) {
-        char* buffer = new char[size + 1];
-        rc = MimerGetString8(stmt, static_cast<int16_t>(col), buffer, size + 1);
+        cell.bytes.resize(size + 1);
+        rc = MimerGetString8(stmt, idx, &cell.bytes[0], size + 1);
         if (rc >= 0) {
-          row.Set(colName, Napi::String::New(env, buffer));
+          cell.bytes.resize(size);
+        } else {
+          cell.kind = RawCell::Null;
+          cell.bytes.clear();
         }
-        delete[] buffer;
-      } else {
-        row.Set(colName, Napi::String::New(env, ""));
       }
     }
   }
+}
+
+uint64_t HashRawRow(const std::vector<RawCell>& cells) {
+  uint64_t h = FNV_OFFSET_BASIS;
+  for (const RawCell& cell : cells) {
+    char tag = static_cast<char>(cell.kind);
+    switch (cell.kind) {
+      case RawCell::Null:
+        h = FnvAppendTagged(h, tag, nullptr, 0);
+        break;
+      case RawCell::Int:
+      case RawCell::Bool:
+        h = FnvAppendTagged(h, tag, &cell.i, sizeof(cell.i));
+        break;
+      case RawCell::Double:
+        h = FnvAppendTagged(h, tag, &cell.d, sizeof(cell.d));
+        break;
+      case RawCell::String:
+      case RawCell::Binary:
+        h = FnvAppendTagged(h, tag, cell.bytes.data(), cell.bytes.size());
+        break;
+    }
+  }
+  return h;
+}
+
+std::string RawCellKey(const RawCell& cell) {
+  std::string key(1, static_cast<char>(cell.kind));
+  switch (cell.kind) {
+    case RawCell::Null:
+      break;
+    case RawCell::Int:
+    case RawCell::Bool:
+      key.append(reinterpret_cast<const char*>(&cell.i), sizeof(cell.i));
+      break;
+    case RawCell::Double:
+      key.append(reinterpret_cast<const char*>(&cell.d), sizeof(cell.d));
+      break;
+    case RawCell::String:
+    case RawCell::Binary:
+      key.append(cell.bytes);
+      break;
+  }
+  return key;
+}
+
+Napi::Value RawCellToValue(Napi::Env env, const RawCell& cell) {
+  switch (cell.kind) {
+    case RawCell::Int:
+      return Napi::Number::New(env, static_cast<double>(cell.i));
+    case RawCell::Double:
+      return Napi::Number::New(env, cell.d);
+    case RawCell::Bool:
+      return Napi::Boolean::New(env, cell.i != 0);
+    case RawCell::String:
+      return NewTextString(env, cell.bytes.data(), cell.bytes.size());
+    case RawCell::Binary:
+      return Napi::Buffer<uint8_t>::Copy(
+          env, reinterpret_cast<const uint8_t*>(cell.bytes.data()), cell.bytes.size());
+    case RawCell::Null:
+    default:
+      return env.Null();
+  }
+}
 
+Napi::Object RawRowToObject(Napi::Env env, const std::vector<RawCell>& cells,
+                            const std::vector<std::string>& colNames) {
+  Napi::Object row = Napi::Object::New(env);
+  for (size_t i = 0; i < cells.size(); i++) {
+    row.Set(colNames[i], RawCellToValue(env, cells[i]));
+  }
   return row;
 }
 
+static bool IsSqlWordChar(char c) {
+  unsigned char u = static_cast<unsigned char>(c);
+  return std::isalnum(u) || c == '_' || c == '$' || c == '#' || u >= 0x80;
+}
+
 /**
- * Fetch all result rows from an open cursor into a JS array of objects.
+ * Split a script into statements. Scans once, skipping literals and
+ * comments, and only splits on ';' outside routine/trigger bodies.
  */
-Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount) {
-  std::vector<std::string> colNames;
-  std::vector<int> colTypes;
-  CacheColumnMetadata(stmt, columnCount, colNames, colTypes);
+std::vector<std::string> SplitSqlScript(const std::string& script) {
+  std::vector<std::string> statements;
+  const size_t n = script.size();
+  size_t start = 0;
+  bool hasCode = false;     // current statement has text outside comments
+  int blockDepth = 0;       // BEGIN/CASE ... END nesting
+  bool afterEnd = false;    // previous word was an END that closed a block
 
-  Napi::Array rows = Napi::Array::New(env);
-  int rowIndex = 0;
+  auto flush = [&](size_t end) {
+    if (hasCode) {
+      size_t first = start;
+      size_t last = end;
+      while (first < last && std::isspace(static_cast<unsigned char>(script[first]))) first++;
+      while (last > first && std::isspace(static_cast<unsigned char>(script[last - 1]))) last--;
+      statements.emplace_back(script, first, last - first);
+    }
+    start = end + 1;
+    hasCode = false;
+    blockDepth = 0;
+    afterEnd = false;
+  };
 
-  while (MimerFetch(stmt) == MIMER_SUCCESS) {
-    Napi::Object row = FetchSingleRow(env, stmt, columnCount, colNames, colTypes);
-    rows.Set(rowIndex++, row);
+  size_t i = 0;
+  while (i < n) {
+    char c = script[i];
+
+    if (c == '-' && i + 1 < n && script[i + 1] == '-') {
+      while (i < n && script[i] != '\n') i++;
+      continue;
+    }
+    if (c == '/' && i + 1 < n && script[i + 1] == '*') {
+      // Bracketed comments nest in SQL
+      int depth = 0;
+      while (i < n) {
+        if (script[i] == '/' && i + 1 < n && script[i + 1] == '*') {
+          depth++;
+          i += 2;
+        } else if (script[i] == '*' && i + 1 < n && script[i + 1] == '/') {
+          i += 2;
+          if (--depth == 0) break;
+        } else {
+          i++;
+        }
+      }
+      continue;
+    }
+    if (c == '\'' || c == '"') {
+      // A doubled quote inside a literal re-enters it on the next pass
+      hasCode = true;
+      i++;
+      while (i < n && script[i] != c) i++;
+      i++;
+      continue;
+    }
+    if (c == ';' && blockDepth == 0) {
+      flush(i);
+      i++;
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      i++;
+      continue;
+    }
+
+    hasCode = true;
+    if (!IsSqlWordChar(c)) {
+      // END; ends the block, so a following IF or CASE starts a new statement
+      afterEnd = false;
+      i++;
+      continue;
+    }
+
+    size_t wordStart = i;
+    while (i < n && IsSqlWordChar(script[i])) i++;
+    std::string word = script.substr(wordStart, i - wordStart);
+    for (char& ch : word) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+    bool closedByEnd = afterEnd;
+    afterEnd = false;
+    if (closedByEnd && (word == "IF" || word == "LOOP" || word == "WHILE" ||
+                        word == "REPEAT" || word == "FOR")) {
+      // END IF / END LOOP / ... close statements that never opened a block
+      blockDepth++;
+      continue;
+    }
+    if (closedByEnd && word == "CASE") {
+      // END CASE: the END already closed the block the CASE opened
+      continue;
+    }
+
+    if (word == "BEGIN" || word == "CASE") {
+      blockDepth++;
+    } else if (word == "END" && blockDepth > 0) {
+      blockDepth--;
+      afterEnd = true;
+    }
   }
+  flush(n);
 
-  return rows;
+  return statements;
+}
+
+/**
+ * Read the first keyword of a statement, past whitespace and comments.
+ */
+bool IsSqlDataDefinition(const std::string& sql) {
+  const size_t n = sql.size();
+  size_t i = 0;
+  while (i < n) {
+    char c = sql[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      i++;
+    } else if (c == '-' && i + 1 < n && sql[i + 1] == '-') {
+      while (i < n && sql[i] != '\n') i++;
+    } else if (c == '/' && i + 1 < n && sql[i + 1] == '*') {
+      size_t close = sql.find("*/", i + 2);
+      i = close == std::string::npos ? n : close + 2;
+    } else {
+      break;
+    }
+  }
+
+  std::string word;
+  while (i < n && IsSqlWordChar(sql[i])) {
+    word += static_cast<char>(std::toupper(static_cast<unsigned char>(sql[i])));
+    i++;
+  }
+  return word == "CREATE" || word == "DROP" || word == "ALTER" ||
+         word == "GRANT" || word == "REVOKE" || word == "COMMENT";
 }
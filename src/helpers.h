@@ -25,8 +25,12 @@
 
 #include <napi.h>
 #include <mimerapi.h>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "stats.h"
 
 /**
  * Create and throw a structured Mimer error as a JS exception.
@@ -38,6 +42,29 @@
 void ThrowMimerError(Napi::Env env, int rc, const std::string& operation,
                      const std::string& detail = "");
 
+/**
+ * Build the same structured error as ThrowMimerError() without throwing it,
+ * for errors that are collected and returned instead.
+ */
+Napi::Error MakeMimerError(Napi::Env env, int rc, const std::string& operation,
+                           const std::string& detail = "");
+
+/**
+ * Split an SQL script into statements on top-level semicolons.
+ * Semicolons inside string literals, quoted identifiers, -- and block
+ * comments, and BEGIN ... END / CASE ... END blocks (routine and trigger
+ * bodies) do not split. Statements are trimmed; empty ones and ones that
+ * contain only comments are dropped.
+ */
+std::vector<std::string> SplitSqlScript(const std::string& script);
+
+/**
+ * True when the statement is data definition (CREATE, DROP, ALTER, GRANT,
+ * REVOKE or COMMENT). Mimer SQL commits DDL on its own, outside any
+ * transaction the caller started. Leading comments are skipped.
+ */
+bool IsSqlDataDefinition(const std::string& sql);
+
 /**
  * Build an array of column metadata objects from a prepared statement.
  * Each element is { name, dataTypeCode, dataTypeName, nullable }.
@@ -49,9 +76,10 @@ Napi::Array BuildFieldsArray(Napi::Env env, MimerStatement stmt, int columnCount
 /**
  * Bind a JavaScript array of parameters to a prepared Mimer statement.
  * Parameter indices are 1-based in the Mimer API, 0-based in the JS array.
- * Throws a JS exception on error.
+ * Throws a JS exception on error. Bind calls are counted in `stats`.
  */
-void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params);
+void BindParameters(Napi::Env env, MimerStatement stmt, Napi::Array params,
+                    OperationStats* stats = nullptr);
 
 /**
  * Cache column names and type codes from a prepared statement.
@@ -61,14 +89,233 @@ void CacheColumnMetadata(MimerStatement stmt, int columnCount,
                          std::vector<std::string>& colNames,
                          std::vector<int>& colTypes);
 
+/**
+ * True for CHARACTER, VARCHAR, NCHAR and NVARCHAR columns (not CLOBs).
+ */
+bool IsCharacterType(int type);
+
+/**
+ * Columns an option applies to: every eligible column (`true` in JS), or
+ * the named ones.
+ */
+struct ColumnSelection {
+  bool all = false;
+  std::vector<std::string> names;
+
+  bool Empty() const { return !all && names.empty(); }
+  bool Includes(const std::string& name) const;
+};
+
+/**
+ * Which columns of a materialized result to intern. `limit` caps the
+ * distinct values kept per column.
+ */
+struct InternOptions {
+  ColumnSelection columns;
+  size_t limit = 1024;
+};
+
+/**
+ * Read at most this much of each LOB; zero reads the whole value.
+ * `bytes` applies to BLOBs, `chars` to CLOBs and NCLOBs.
+ */
+struct LobPreview {
+  size_t bytes = 0;
+  size_t chars = 0;
+};
+
+/**
+ * Group a JOIN result under its parent rows: rows with the same
+ * `parentKey` value become one parent object holding the non-child
+ * columns, with the `childColumns` of each row collected in an array
+ * named `as`.
+ */
+struct NestOptions {
+  std::string parentKey;
+  std::vector<std::string> childColumns;
+  std::string as = "children";
+};
+
+/**
+ * Per-query options that change how values are turned into JS values.
+ * `rawText` selects character columns returned as UTF-8 bytes. `keyBy`
+ * and `nest` change the shape of `rows` (see FetchShaped()).
+ */
+struct DecodeOptions {
+  InternOptions intern;
+  bool binarySlab = false;
+  ColumnSelection rawText;
+  LobPreview lobPreview;
+  Napi::Function rowFactory;  // rows are `new rowFactory()` when set
+  Napi::Object fieldMap;      // column name -> property name
+  std::string keyBy;
+  NestOptions nest;
+
+  bool Shaped() const { return !keyBy.empty() || !nest.parentKey.empty(); }
+};
+
+/**
+ * Apply { intern, internLimit, binarySlab, rawText, lobPreview,
+ * rowFactory, fieldMap } from a JS options object. Throws a TypeError and
+ * returns false on invalid values.
+ */
+bool ParseDecodeOptions(Napi::Env env, Napi::Value options, DecodeOptions& decode);
+
+/**
+ * Per-column tables that hand out the same JS string for repeated values
+ * during one fetch. A column whose distinct values exceed the limit is
+ * dropped from interning and decoded normally from then on. The stored
+ * handles are only valid inside the native call that created them.
+ */
+class StringInterner {
+public:
+  StringInterner(const std::vector<std::string>& colNames,
+                 const InternOptions& options);
+
+  bool Active(int col) const { return columns_[col].active; }
+
+  // Return the string for `data` in column `col` (0-based), creating it once
+  Napi::Value Get(Napi::Env env, int col, const char* data, size_t length);
+
+private:
+  struct Column {
+    bool active = false;
+    std::unordered_map<std::string, Napi::Value> values;
+  };
+  std::vector<Column> columns_;
+  size_t limit_;
+};
+
+/**
+ * Packs byte values from many rows into shared ArrayBuffers. Add() copies
+ * a value into the current slab and remembers where it belongs; Flush()
+ * (run automatically once a slab is full) creates one ArrayBuffer and sets
+ * each value as a Uint8Array view into it. Like StringInterner, it holds
+ * handles that are only valid inside one native call.
+ */
+class ByteSlab {
+public:
+  explicit ByteSlab(Napi::Env env) : env_(env) {}
+
+  void Add(Napi::Object row, Napi::Value key,
+           const uint8_t* data, size_t length);
+  void Flush();
+
+private:
+  struct Pending {
+    Napi::Object row;
+    Napi::Value key;
+    size_t offset;
+    size_t length;
+  };
+  Napi::Env env_;
+  std::vector<uint8_t> data_;
+  std::vector<Pending> pending_;
+};
+
+/**
+ * Wall-clock time spent in each phase of one statement, in milliseconds,
+ * plus the rows and approximate bytes converted. `fetch` is time inside
+ * MimerFetch(); `convert` is time building JS values. Lap() charges the
+ * time since the previous lap to a phase. Also used for the per-connection
+ * totals, where `statements` counts the timed statements.
+ */
+struct PhaseTiming {
+  using Clock = std::chrono::steady_clock;
+
+  double prepare = 0;
+  double bind = 0;
+  double execute = 0;
+  double fetch = 0;
+  double convert = 0;
+  uint64_t rows = 0;
+  uint64_t bytes = 0;
+  uint64_t statements = 0;
+  Clock::time_point mark = Clock::now();
+
+  void Lap(double& phase) {
+    Clock::time_point now = Clock::now();
+    phase += std::chrono::duration<double, std::milli>(now - mark).count();
+    mark = now;
+  }
+  void Add(const PhaseTiming& other);
+  Napi::Object ToObject(Napi::Env env) const;
+};
+
+/**
+ * Read the `timing` flag from a JS options object into `enabled`.
+ * Non-object values and a missing flag leave it unchanged.
+ */
+void ParseTiming(Napi::Value options, bool& enabled);
+
+/**
+ * Decoding state for one fetch, built from DecodeOptions. Members are
+ * null or empty when the corresponding option is off. `timing` is set by
+ * the caller when phase timing is on, `stats` to count rows and cells.
+ */
+struct FetchContext {
+  FetchContext(Napi::Env env, const std::vector<std::string>& colNames,
+               const std::vector<int>& colTypes, const DecodeOptions& options);
+
+  std::unique_ptr<StringInterner> interner;
+  std::unique_ptr<ByteSlab> slab;
+  std::vector<bool> rawText;  // per column; empty when the option is off
+  LobPreview lobPreview;
+  Napi::Function rowFactory;
+  std::vector<Napi::Value> keys;  // property key per column, created once
+  PhaseTiming* timing = nullptr;
+  OperationStats* stats = nullptr;
+};
+
 /**
  * Fetch a single row from an open cursor into a JS object.
  * Assumes MimerFetch() has already returned MIMER_SUCCESS for this row.
  * Column metadata must have been cached via CacheColumnMetadata().
+ * If `bytes` is given, the approximate size of the row's values (string
+ * and binary lengths, 8 bytes for other values) is added to it.
  */
 Napi::Object FetchSingleRow(Napi::Env env, MimerStatement stmt, int columnCount,
                              const std::vector<std::string>& colNames,
-                             const std::vector<int>& colTypes);
+                             const std::vector<int>& colTypes,
+                             size_t* bytes = nullptr,
+                             FetchContext* context = nullptr);
+
+/**
+ * Like FetchSingleRow(), but writes the values into an existing object so
+ * one row object can be reused across fetches. With `overwrite`, a column
+ * that cannot be read is set to undefined instead of being left as is.
+ */
+void FillRow(Napi::Env env, MimerStatement stmt, int columnCount,
+             const std::vector<std::string>& colNames,
+             const std::vector<int>& colTypes,
+             Napi::Object row, bool overwrite, size_t* bytes = nullptr,
+             FetchContext* context = nullptr);
+
+/**
+ * Bounds on how much of a result is materialized by FetchResults().
+ * Zero means unlimited. When a limit is hit, fetching stops and either a
+ * JS error (with `limit` set to "maxRows" or "maxBytes") is thrown or the
+ * result is flagged as truncated.
+ */
+struct FetchLimits {
+  uint64_t maxRows = 0;
+  size_t maxBytes = 0;
+  bool throwOnLimit = true;
+};
+
+/**
+ * Apply { maxRows, maxBytes, onLimit: 'error' | 'truncate' } from a JS
+ * options object on top of `limits`. Non-object values leave it unchanged.
+ * Throws a TypeError and returns false on invalid values.
+ */
+bool ParseFetchLimits(Napi::Env env, Napi::Value options, FetchLimits& limits);
+
+/**
+ * Handle a limit that was hit: in error mode throw an Error with `limit`
+ * set, otherwise set *truncated.
+ */
+void ReportFetchLimit(Napi::Env env, const FetchLimits& limits,
+                      const char* limit, uint64_t value, bool* truncated);
 
 /**
  * Fetch all result rows from an open cursor into a JS array of objects.
@@ -76,4 +323,94 @@ Napi::Object FetchSingleRow(Napi::Env env, MimerStatement stmt, int columnCount,
  */
 Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount);
 
+/**
+ * Same as above, using column metadata cached by the caller.
+ */
+Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes);
+
+/**
+ * Same as above, stopping at `limits`. Sets *truncated when a limit was
+ * hit in truncate mode; in error mode a JS exception is left pending.
+ * Values are decoded through `context` when one is given.
+ */
+Napi::Array FetchResults(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes,
+                         const FetchLimits& limits, bool* truncated,
+                         FetchContext* context = nullptr);
+
+/**
+ * Like the limited FetchResults(), but shape the rows as `decode` asks:
+ * with `keyBy`, a Map from that column's value to the row (a later row
+ * replaces an earlier one with the same key); with `nest`, an array of
+ * parent objects in first-seen order. Only the key column of a parent
+ * that has already been seen is decoded. *rowCount receives the number
+ * of rows fetched. Throws (leaves a pending exception) if a named column
+ * is not in the result.
+ */
+Napi::Value FetchShaped(Napi::Env env, MimerStatement stmt, int columnCount,
+                        const std::vector<std::string>& colNames,
+                        const std::vector<int>& colTypes,
+                        const FetchLimits& limits, bool* truncated,
+                        FetchContext* context, const DecodeOptions& decode,
+                        size_t* rowCount);
+
+/**
+ * A column value read from the current row without creating a JS value.
+ * Integer and boolean values are kept in `i`, floating point in `d`,
+ * character data as UTF-8 and binary/BLOB data as raw bytes in `bytes`.
+ */
+struct RawCell {
+  enum Kind : uint8_t { Null, Int, Double, Bool, String, Binary };
+  Kind kind = Null;
+  int64_t i = 0;
+  double d = 0;
+  std::string bytes;
+};
+
+/**
+ * Read every column of the current row into native cells, using the same
+ * type dispatch as FetchSingleRow(). Assumes MimerFetch() has returned
+ * MIMER_SUCCESS. `cells` is resized to columnCount and reused across rows.
+ */
+void ReadRawRow(MimerStatement stmt, int columnCount,
+                const std::vector<int>& colTypes,
+                std::vector<RawCell>& cells);
+
+/**
+ * Hash a row of native cells (FNV-1a over kind tags and values).
+ */
+uint64_t HashRawRow(const std::vector<RawCell>& cells);
+
+/**
+ * Byte string that uniquely identifies a cell value, for use as a map key.
+ */
+std::string RawCellKey(const RawCell& cell);
+
+/**
+ * Convert a native cell to the JS value FetchSingleRow() would produce.
+ */
+Napi::Value RawCellToValue(Napi::Env env, const RawCell& cell);
+
+/**
+ * Build a JS row object from native cells.
+ */
+Napi::Object RawRowToObject(Napi::Env env, const std::vector<RawCell>& cells,
+                            const std::vector<std::string>& colNames);
+
+/**
+ * Compute a 64-bit FNV-1a hash over a JavaScript parameter array.
+ * Each value contributes a type tag followed by its bytes, so [1] and ['1']
+ * hash differently. Intended for deduplication/cache keys, not security.
+ */
+uint64_t HashParameters(Napi::Array params);
+
+/**
+ * JS-exposed module function: hashParams(params) returns the
+ * HashParameters() value as a 16-character hex string.
+ */
+Napi::Value HashParams(const Napi::CallbackInfo& info);
+
 #endif // MIMER_HELPERS_H
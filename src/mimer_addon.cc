@@ -24,6 +24,9 @@
 #include "connection.h"
 #include "statement.h"
 #include "resultset.h"
+#include "helpers.h"
+#include "spill.h"
+#include "stats.h"
 
 /**
  * Initialize the Mimer addon module
@@ -39,6 +42,22 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   // Export the ResultSet class
   MimerResultSetWrapper::Init(env, exports);
 
+  // Export the SpilledRows class (results fetched with { spill })
+  MimerSpilledRows::Init(env, exports);
+
+  // Export module-level utility functions
+  exports.Set("hashParams", Napi::Function::New(env, HashParams, "hashParams"));
+  exports.Set("getStats", Napi::Function::New(env, GetGlobalStats, "getStats"));
+  exports.Set("recordStatement",
+              Napi::Function::New(env, RecordStatement, "recordStatement"));
+  exports.Set("getStatementStats",
+              Napi::Function::New(env, GetStatementStats, "getStatementStats"));
+  exports.Set("resetStatementStats",
+              Napi::Function::New(env, ResetStatementStats, "resetStatementStats"));
+  exports.Set("configureStatementStats",
+              Napi::Function::New(env, ConfigureStatementStats, "configureStatementStats"));
+  exports.Set("statementLatencyBuckets", LatencyBucketBounds(env));
+
   // Export version information
   exports.Set("version", Napi::String::New(env, "1.0.0"));
 
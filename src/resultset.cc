@@ -22,14 +22,20 @@
 
 #include "resultset.h"
 #include "connection.h"
+#include "statement.h"
 #include "helpers.h"
 
 Napi::FunctionReference MimerResultSetWrapper::constructor_;
 
+// Rows a cursor fetches between publishes of its counters
+static constexpr uint64_t STATS_PUBLISH_ROWS = 1024;
+
 Napi::Object MimerResultSetWrapper::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "ResultSet", {
     InstanceMethod("fetchNext", &MimerResultSetWrapper::FetchNext),
+    InstanceMethod("fetchBatch", &MimerResultSetWrapper::FetchBatch),
     InstanceMethod("getFields", &MimerResultSetWrapper::GetFields),
+    InstanceMethod("setReuseRow", &MimerResultSetWrapper::SetReuseRow),
     InstanceMethod("close", &MimerResultSetWrapper::Close),
     InstanceMethod("isClosed", &MimerResultSetWrapper::IsClosed)
   });
@@ -55,12 +61,28 @@ Napi::Object MimerResultSetWrapper::NewInstance(Napi::Env env,
 }
 
 /**
- * Constructor — receives External<MimerStatement> and columnCount.
+ * Create a ResultSet over a cursor opened on a prepared statement's handle.
+ * The statement keeps the handle; closing the result set closes the cursor.
+ */
+Napi::Object MimerResultSetWrapper::NewInstance(Napi::Env env,
+                                                 MimerStatement stmt,
+                                                 int columnCount,
+                                                 Napi::Object owner) {
+  Napi::External<MimerStatement> extStmt =
+      Napi::External<MimerStatement>::New(env, new MimerStatement(stmt));
+  Napi::Number colCount = Napi::Number::New(env, columnCount);
+  return constructor_.New({extStmt, colCount, owner});
+}
+
+/**
+ * Constructor — receives External<MimerStatement>, columnCount and
+ * optionally the owning Statement object.
  */
 MimerResultSetWrapper::MimerResultSetWrapper(const Napi::CallbackInfo& info)
   : Napi::ObjectWrap<MimerResultSetWrapper>(info),
     stmt_(MIMERNULLHANDLE), columnCount_(0),
-    closed_(false), exhausted_(false), parentConnection_(nullptr) {
+    closed_(false), exhausted_(false), parentConnection_(nullptr),
+    reuseRow_(false), ownerStatement_(nullptr) {
   Napi::Env env = info.Env();
 
   if (info.Length() < 2 || !info[0].IsExternal() || !info[1].IsNumber()) {
@@ -76,6 +98,12 @@ MimerResultSetWrapper::MimerResultSetWrapper(const Napi::CallbackInfo& info)
 
   columnCount_ = info[1].As<Napi::Number>().Int32Value();
 
+  if (info.Length() >= 3 && info[2].IsObject()) {
+    Napi::Object owner = info[2].As<Napi::Object>();
+    ownerStatement_ = MimerStmtWrapper::Unwrap(owner);
+    ownerRef_ = Napi::Persistent(owner);
+  }
+
   // Cache column metadata once
   CacheColumnMetadata(stmt_, columnCount_, colNames_, colTypes_);
 }
@@ -88,13 +116,31 @@ void MimerResultSetWrapper::SetParentConnection(MimerConnection* conn) {
   parentConnection_ = conn;
 }
 
+/**
+ * Called by the owning statement before it ends its handle. The cursor is
+ * closed but the statement handle is left to the statement.
+ */
+void MimerResultSetWrapper::DetachFromStatement() {
+  PublishStats();
+  if (!closed_ && stmt_ != MIMERNULLHANDLE) {
+    MimerCloseCursor(stmt_);
+  }
+  closed_ = true;
+  stmt_ = MIMERNULLHANDLE;
+  ownerStatement_ = nullptr;
+  ownerRef_.Reset();
+  parentConnection_ = nullptr;
+}
+
 /**
  * Called by MimerConnection::Close() — close handles without unregistering.
  */
 void MimerResultSetWrapper::Invalidate() {
+  PublishStats();
   if (!closed_ && stmt_ != MIMERNULLHANDLE) {
     MimerCloseCursor(stmt_);
     MimerEndStatement(&stmt_);
+    CountOperation(ConnectionStats(parentConnection_), STAT_STATEMENTS_ENDED);
   }
   closed_ = true;
   parentConnection_ = nullptr;
@@ -104,9 +150,25 @@ void MimerResultSetWrapper::Invalidate() {
  * Close handles AND unregister from parent connection.
  */
 void MimerResultSetWrapper::CloseInternal() {
+  PublishStats();
+  if (ownerStatement_) {
+    // Borrowed handle: close only the cursor and hand the statement back
+    MimerStmtWrapper* owner = ownerStatement_;
+    if (!closed_ && stmt_ != MIMERNULLHANDLE) {
+      MimerCloseCursor(stmt_);
+    }
+    closed_ = true;
+    ownerStatement_ = nullptr;
+    parentConnection_ = nullptr;
+    owner->CursorClosed(this);
+    ownerRef_.Reset();
+    return;
+  }
+
   if (!closed_ && stmt_ != MIMERNULLHANDLE) {
     MimerCloseCursor(stmt_);
     MimerEndStatement(&stmt_);
+    CountOperation(ConnectionStats(parentConnection_), STAT_STATEMENTS_ENDED);
   }
   closed_ = true;
   if (parentConnection_) {
@@ -119,22 +181,88 @@ void MimerResultSetWrapper::CloseInternal() {
  * Fetch the next row. Returns a JS object, or null when exhausted / closed.
  */
 Napi::Value MimerResultSetWrapper::FetchNext(const Napi::CallbackInfo& info) {
+  return FetchRow(info.Env(), reuseRow_);
+}
+
+/**
+ * Fetch up to `max` rows (default 1) in one call. Returns an array that is
+ * shorter than `max` only when the cursor is exhausted or closed. Rows are
+ * always separate objects, whatever the reuseRow setting.
+ */
+Napi::Value MimerResultSetWrapper::FetchBatch(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  uint32_t max = info.Length() > 0 && info[0].IsNumber()
+      ? info[0].As<Napi::Number>().Uint32Value() : 1;
+  if (max == 0) {
+    max = 1;
+  }
+
+  Napi::Array rows = Napi::Array::New(env);
+  for (uint32_t i = 0; i < max; i++) {
+    Napi::Value row = FetchRow(env, false);
+    if (row.IsNull()) {
+      break;
+    }
+    rows.Set(i, row);
+  }
+  return rows;
+}
 
+/**
+ * Fetch one row, into row_ when reuse is set. Returns null when exhausted
+ * or closed.
+ */
+Napi::Value MimerResultSetWrapper::FetchRow(Napi::Env env, bool reuse) {
   if (closed_ || exhausted_) {
     return env.Null();
   }
 
   int rc = MimerFetch(stmt_);
   if (rc == MIMER_SUCCESS) {
-    return FetchSingleRow(env, stmt_, columnCount_, colNames_, colTypes_);
+    if (!context_) {
+      context_.reset(new FetchContext(env, colNames_, colTypes_, DecodeOptions()));
+      context_->stats = &pendingStats_;
+      keyRefs_.reserve(context_->keys.size());
+      for (const Napi::Value& key : context_->keys) {
+        keyRefs_.push_back(Napi::Persistent(key));
+      }
+    } else {
+      for (size_t i = 0; i < keyRefs_.size(); i++) {
+        context_->keys[i] = keyRefs_[i].Value();
+      }
+    }
+    pendingStats_.Count(STAT_ROWS_FETCHED);
+    if (pendingStats_.counts[STAT_ROWS_FETCHED] >= STATS_PUBLISH_ROWS) {
+      PublishStats();
+    }
+    if (!reuse) {
+      return FetchSingleRow(env, stmt_, columnCount_, colNames_, colTypes_,
+                            nullptr, context_.get());
+    }
+    if (row_.IsEmpty()) {
+      row_ = Napi::Persistent(Napi::Object::New(env));
+    }
+    Napi::Object row = row_.Value();
+    FillRow(env, stmt_, columnCount_, colNames_, colTypes_, row, true,
+            nullptr, context_.get());
+    return row;
   }
 
   // No more rows (or error) — mark exhausted
   exhausted_ = true;
+  PublishStats();
   return env.Null();
 }
 
+/**
+ * Add the counters accumulated since the last call to the connection and
+ * process totals.
+ */
+void MimerResultSetWrapper::PublishStats() {
+  AddOperationStats(ConnectionStats(parentConnection_), pendingStats_);
+  pendingStats_ = OperationStats();
+}
+
 /**
  * Return column metadata array (same format as fields in query results).
  */
@@ -148,6 +276,18 @@ Napi::Value MimerResultSetWrapper::GetFields(const Napi::CallbackInfo& info) {
   return BuildFieldsArray(env, stmt_, columnCount_);
 }
 
+/**
+ * Toggle reuseRow mode. While on, fetchNext() returns the same object for
+ * every row, overwriting its properties in place.
+ */
+Napi::Value MimerResultSetWrapper::SetReuseRow(const Napi::CallbackInfo& info) {
+  reuseRow_ = info.Length() > 0 && info[0].ToBoolean().Value();
+  if (!reuseRow_) {
+    row_.Reset();
+  }
+  return info.Env().Undefined();
+}
+
 /**
  * Explicitly close the cursor and release the statement handle.
  */
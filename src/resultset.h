@@ -25,15 +25,22 @@
 
 #include <napi.h>
 #include <mimerapi.h>
+#include <memory>
 #include <vector>
 #include <string>
+#include "helpers.h"
+#include "stats.h"
 
 class MimerConnection; // forward declaration
+class MimerStmtWrapper; // forward declaration
 
 /**
  * MimerResultSetWrapper wraps an open Mimer cursor for row-at-a-time
  * fetching.  Owns the MimerStatement handle (cursor already opened by
- * MimerConnection::ExecuteQuery).
+ * MimerConnection::ExecuteQuery), or — when opened by
+ * MimerStmtWrapper::ExecuteCursor — borrows the prepared statement's
+ * handle and only closes the cursor. A borrowed result set holds a
+ * reference to the statement object so it outlives the cursor.
  *
  * Lifecycle follows the same pattern as MimerStmtWrapper:
  *   - Invalidate()   — called by connection close (closes handles, no unregister)
@@ -45,12 +52,17 @@ public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   static Napi::Object NewInstance(Napi::Env env, MimerStatement stmt,
                                   int columnCount);
+  static Napi::Object NewInstance(Napi::Env env, MimerStatement stmt,
+                                  int columnCount, Napi::Object owner);
   MimerResultSetWrapper(const Napi::CallbackInfo& info);
   ~MimerResultSetWrapper();
 
   void SetParentConnection(MimerConnection* conn);
   void Invalidate();
 
+  // Called by the owning statement when it is closed or invalidated
+  void DetachFromStatement();
+
 private:
   MimerStatement stmt_;
   int columnCount_;
@@ -60,13 +72,34 @@ private:
   bool exhausted_;
   MimerConnection* parentConnection_;
 
+  // reuseRow mode: one row object overwritten by every fetch
+  bool reuseRow_;
+  Napi::ObjectReference row_;
+
+  // Decode state built on the first fetch and reused for every row; the
+  // property keys are held persistently since handles die with each call
+  std::unique_ptr<FetchContext> context_;
+  std::vector<Napi::Reference<Napi::Value>> keyRefs_;
+
+  // Counters for the rows fetched so far, published to the connection and
+  // process totals in batches rather than per row
+  OperationStats pendingStats_;
+
+  // Owning prepared statement (borrowed handle), or nullptr
+  MimerStmtWrapper* ownerStatement_;
+  Napi::ObjectReference ownerRef_;
+
   // JS-exposed methods
   Napi::Value FetchNext(const Napi::CallbackInfo& info);
+  Napi::Value FetchBatch(const Napi::CallbackInfo& info);
   Napi::Value GetFields(const Napi::CallbackInfo& info);
+  Napi::Value SetReuseRow(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
   Napi::Value IsClosed(const Napi::CallbackInfo& info);
 
+  Napi::Value FetchRow(Napi::Env env, bool reuse);
   void CloseInternal();
+  void PublishStats();
 
   static Napi::FunctionReference constructor_;
 };
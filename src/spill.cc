@@ -0,0 +1,304 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+#include "spill.h"
+#include <cstring>
+
+Napi::FunctionReference MimerSpilledRows::constructor_;
+
+bool ParseSpillOptions(Napi::Env env, Napi::Value options, SpillOptions& spill) {
+  if (!options.IsObject()) {
+    return true;
+  }
+  Napi::Value value = options.As<Napi::Object>().Get("spill");
+  if (value.IsUndefined() || value.IsNull() || value.IsBoolean()) {
+    spill.enabled = value.IsBoolean() && value.As<Napi::Boolean>().Value();
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "spill must be a boolean or an options object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  spill.enabled = true;
+  Napi::Value memoryBytes = value.As<Napi::Object>().Get("memoryBytes");
+  if (!memoryBytes.IsUndefined()) {
+    if (!memoryBytes.IsNumber() || memoryBytes.As<Napi::Number>().DoubleValue() < 0) {
+      Napi::TypeError::New(env, "spill.memoryBytes must be a non-negative number")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    spill.memoryBytes = static_cast<size_t>(memoryBytes.As<Napi::Number>().DoubleValue());
+  }
+  return true;
+}
+
+/**
+ * Row encoding: per cell a kind byte, then 8 bytes for Int/Bool/Double or a
+ * uint32 length plus the bytes for String/Binary. Null has no payload.
+ */
+static void EncodeRow(const std::vector<RawCell>& cells, std::string& out) {
+  out.clear();
+  for (const RawCell& cell : cells) {
+    out.push_back(static_cast<char>(cell.kind));
+    switch (cell.kind) {
+      case RawCell::Null:
+        break;
+      case RawCell::Int:
+      case RawCell::Bool:
+        out.append(reinterpret_cast<const char*>(&cell.i), sizeof(cell.i));
+        break;
+      case RawCell::Double:
+        out.append(reinterpret_cast<const char*>(&cell.d), sizeof(cell.d));
+        break;
+      case RawCell::String:
+      case RawCell::Binary: {
+        uint32_t len = static_cast<uint32_t>(cell.bytes.size());
+        out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.append(cell.bytes);
+        break;
+      }
+    }
+  }
+}
+
+static void DecodeRow(const char* data, size_t columnCount,
+                      std::vector<RawCell>& cells) {
+  cells.resize(columnCount);
+  for (RawCell& cell : cells) {
+    cell.kind = static_cast<RawCell::Kind>(*data++);
+    cell.bytes.clear();
+    switch (cell.kind) {
+      case RawCell::Null:
+        break;
+      case RawCell::Int:
+      case RawCell::Bool:
+        std::memcpy(&cell.i, data, sizeof(cell.i));
+        data += sizeof(cell.i);
+        break;
+      case RawCell::Double:
+        std::memcpy(&cell.d, data, sizeof(cell.d));
+        data += sizeof(cell.d);
+        break;
+      case RawCell::String:
+      case RawCell::Binary: {
+        uint32_t len;
+        std::memcpy(&len, data, sizeof(len));
+        data += sizeof(len);
+        cell.bytes.assign(data, len);
+        data += len;
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * 64-bit seek; spill files can exceed 2 GB.
+ */
+static int SeekTo(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+RowStore::RowStore(size_t memoryBytes)
+  : memoryLimit_(memoryBytes), memoryRows_(0), file_(nullptr), fileSize_(0) {}
+
+RowStore::~RowStore() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+bool RowStore::Append(const std::vector<RawCell>& cells) {
+  EncodeRow(cells, encoded_);
+
+  if (file_ == nullptr && memory_.size() + encoded_.size() <= memoryLimit_) {
+    offsets_.push_back(memory_.size());
+    memory_.append(encoded_);
+    memoryRows_++;
+    return true;
+  }
+
+  if (file_ == nullptr) {
+    file_ = std::tmpfile();
+    if (file_ == nullptr) {
+      return false;
+    }
+  }
+  if (std::fwrite(encoded_.data(), 1, encoded_.size(), file_) != encoded_.size()) {
+    return false;
+  }
+  offsets_.push_back(fileSize_);
+  fileSize_ += encoded_.size();
+  return true;
+}
+
+bool RowStore::Read(size_t index, size_t columnCount, std::vector<RawCell>& cells) {
+  if (index < memoryRows_) {
+    DecodeRow(memory_.data() + offsets_[index], columnCount, cells);
+    return true;
+  }
+
+  uint64_t start = offsets_[index];
+  uint64_t end = index + 1 < offsets_.size() ? offsets_[index + 1] : fileSize_;
+  scratch_.resize(static_cast<size_t>(end - start));
+  // Seeking also switches the stream from writing to reading
+  if (SeekTo(file_, start) != 0 ||
+      std::fread(&scratch_[0], 1, scratch_.size(), file_) != scratch_.size()) {
+    return false;
+  }
+  DecodeRow(scratch_.data(), columnCount, cells);
+  return true;
+}
+
+namespace {
+// Carries the store and column names through the JS constructor
+struct SpillPayload {
+  std::unique_ptr<RowStore> store;
+  std::vector<std::string> colNames;
+};
+}
+
+Napi::Object MimerSpilledRows::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "SpilledRows", {
+    InstanceMethod("get", &MimerSpilledRows::Get),
+    InstanceMethod("getLength", &MimerSpilledRows::GetLength),
+    InstanceMethod("isSpilled", &MimerSpilledRows::IsSpilled),
+    InstanceMethod("close", &MimerSpilledRows::Close)
+  });
+
+  constructor_ = Napi::Persistent(func);
+  constructor_.SuppressDestruct();
+
+  exports.Set("SpilledRows", func);
+  return exports;
+}
+
+Napi::Object MimerSpilledRows::NewInstance(Napi::Env env,
+                                           std::unique_ptr<RowStore> store,
+                                           const std::vector<std::string>& colNames) {
+  SpillPayload* payload = new SpillPayload{std::move(store), colNames};
+  return constructor_.New({Napi::External<SpillPayload>::New(env, payload)});
+}
+
+MimerSpilledRows::MimerSpilledRows(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<MimerSpilledRows>(info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsExternal()) {
+    Napi::TypeError::New(env, "SpilledRows cannot be constructed directly; use execute() with { spill }")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  SpillPayload* payload = info[0].As<Napi::External<SpillPayload>>().Data();
+  store_ = std::move(payload->store);
+  colNames_ = std::move(payload->colNames);
+  delete payload;
+}
+
+/**
+ * Decode and return row `index` as a JS object.
+ */
+Napi::Value MimerSpilledRows::Get(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!store_) {
+    Napi::Error::New(env, "Spilled result is closed")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected row index")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double index = info[0].As<Napi::Number>().DoubleValue();
+  if (index < 0 || index >= static_cast<double>(store_->Size()) ||
+      index != static_cast<double>(static_cast<size_t>(index))) {
+    Napi::RangeError::New(env, "Row index out of range")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!store_->Read(static_cast<size_t>(index), colNames_.size(), cells_)) {
+    Napi::Error::New(env, "Could not read spilled row from temporary file")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  return RawRowToObject(env, cells_, colNames_);
+}
+
+Napi::Value MimerSpilledRows::GetLength(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(),
+                           store_ ? static_cast<double>(store_->Size()) : 0);
+}
+
+Napi::Value MimerSpilledRows::IsSpilled(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), store_ && store_->Spilled());
+}
+
+/**
+ * Release the rows and remove the temporary file. Safe to call twice.
+ */
+Napi::Value MimerSpilledRows::Close(const Napi::CallbackInfo& info) {
+  store_.reset();
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+/**
+ * Fetch the remaining rows of an open cursor into a RowStore.
+ */
+Napi::Value FetchSpilled(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes,
+                         const SpillOptions& spill, const FetchLimits& limits,
+                         bool* truncated, size_t* rowCount) {
+  std::unique_ptr<RowStore> store(new RowStore(spill.memoryBytes));
+  std::vector<RawCell> cells;
+
+  while (MimerFetch(stmt) == MIMER_SUCCESS) {
+    if (limits.maxRows > 0 && store->Size() >= limits.maxRows) {
+      ReportFetchLimit(env, limits, "maxRows", limits.maxRows, truncated);
+      if (env.IsExceptionPending()) {
+        return env.Undefined();
+      }
+      break;
+    }
+    ReadRawRow(stmt, columnCount, colTypes, cells);
+    if (!store->Append(cells)) {
+      Napi::Error::New(env, "Could not write spilled rows to a temporary file")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  *rowCount = store->Size();
+  return MimerSpilledRows::NewInstance(env, std::move(store), colNames);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+#ifndef MIMER_SPILL_H
+#define MIMER_SPILL_H
+
+#include <napi.h>
+#include <mimerapi.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "helpers.h"
+
+/**
+ * The `spill` option of execute(): keep up to memoryBytes of encoded rows
+ * in memory and write the rest to a temporary file.
+ */
+struct SpillOptions {
+  bool enabled = false;
+  size_t memoryBytes = 64 * 1024 * 1024;
+};
+
+/**
+ * Read `spill` (true, or { memoryBytes }) from a JS options object.
+ * Throws a TypeError and returns false on invalid values.
+ */
+bool ParseSpillOptions(Napi::Env env, Napi::Value options, SpillOptions& spill);
+
+/**
+ * RowStore keeps rows in a compact binary encoding of RawCell values.
+ * Rows are appended to an in-memory buffer until it reaches the memory
+ * limit; later rows go to an anonymous temporary file (std::tmpfile), which
+ * is removed when the store is destroyed. Rows are decoded on demand by
+ * index.
+ */
+class RowStore {
+public:
+  explicit RowStore(size_t memoryBytes);
+  ~RowStore();
+
+  RowStore(const RowStore&) = delete;
+  RowStore& operator=(const RowStore&) = delete;
+
+  // Returns false if the temporary file could not be created or written
+  bool Append(const std::vector<RawCell>& cells);
+
+  // Decode row `index` into cells. Returns false on a read error.
+  bool Read(size_t index, size_t columnCount, std::vector<RawCell>& cells);
+
+  size_t Size() const { return offsets_.size(); }
+  bool Spilled() const { return file_ != nullptr; }
+
+private:
+  size_t memoryLimit_;
+  std::string memory_;             // encoded rows [0, memoryRows_)
+  size_t memoryRows_;
+  std::FILE* file_;                // encoded rows [memoryRows_, Size())
+  uint64_t fileSize_;
+  std::vector<uint64_t> offsets_;  // row start in memory_ or in file_
+  std::string encoded_;            // scratch buffer for Append()
+  std::string scratch_;            // scratch buffer for file reads
+};
+
+/**
+ * MimerSpilledRows exposes a RowStore to JS as an indexed row accessor.
+ * It does not depend on the statement or connection that produced it.
+ */
+class MimerSpilledRows : public Napi::ObjectWrap<MimerSpilledRows> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::Object NewInstance(Napi::Env env, std::unique_ptr<RowStore> store,
+                                  const std::vector<std::string>& colNames);
+  MimerSpilledRows(const Napi::CallbackInfo& info);
+
+private:
+  std::unique_ptr<RowStore> store_;
+  std::vector<std::string> colNames_;
+  std::vector<RawCell> cells_;
+
+  // JS-exposed methods
+  Napi::Value Get(const Napi::CallbackInfo& info);
+  Napi::Value GetLength(const Napi::CallbackInfo& info);
+  Napi::Value IsSpilled(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+
+  static Napi::FunctionReference constructor_;
+};
+
+/**
+ * Fetch all rows from an open cursor into a RowStore and wrap it in a
+ * MimerSpilledRows object. Honors limits.maxRows (maxBytes does not apply,
+ * since spilled rows are not held in memory). Sets *rowCount.
+ */
+Napi::Value FetchSpilled(Napi::Env env, MimerStatement stmt, int columnCount,
+                         const std::vector<std::string>& colNames,
+                         const std::vector<int>& colTypes,
+                         const SpillOptions& spill, const FetchLimits& limits,
+                         bool* truncated, size_t* rowCount);
+
+#endif // MIMER_SPILL_H
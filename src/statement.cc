@@ -22,17 +22,25 @@
 
 #include "statement.h"
 #include "connection.h"
+#include "resultset.h"
 #include "helpers.h"
+#include "spill.h"
 #include <sstream>
 
 Napi::FunctionReference MimerStmtWrapper::constructor_;
 
+// Parameter sets sent per MimerExecute by executeMany()
+static constexpr uint32_t EXECUTE_BATCH_CHUNK = 1000;
+
 /**
  * Initialize the Statement class and export it
  */
 Napi::Object MimerStmtWrapper::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "Statement", {
     InstanceMethod("execute", &MimerStmtWrapper::Execute),
+    InstanceMethod("executeMany", &MimerStmtWrapper::ExecuteMany),
+    InstanceMethod("executeDiff", &MimerStmtWrapper::ExecuteDiff),
+    InstanceMethod("executeCursor", &MimerStmtWrapper::ExecuteCursor),
     InstanceMethod("close", &MimerStmtWrapper::Close)
   });
 
@@ -63,7 +71,7 @@ Napi::Object MimerStmtWrapper::NewInstance(Napi::Env env, MimerSession session,
 MimerStmtWrapper::MimerStmtWrapper(const Napi::CallbackInfo& info)
   : Napi::ObjectWrap<MimerStmtWrapper>(info),
     stmt_(MIMERNULLHANDLE), columnCount_(0), closed_(false),
-    parentConnection_(nullptr) {
+    parentConnection_(nullptr), activeCursor_(nullptr) {
   Napi::Env env = info.Env();
 
   if (info.Length() < 2 || !info[0].IsExternal() || !info[1].IsString()) {
@@ -86,6 +94,9 @@ MimerStmtWrapper::MimerStmtWrapper(const Napi::CallbackInfo& info)
   }
 
   columnCount_ = MimerColumnCount(stmt_);
+  if (columnCount_ > 0) {
+    CacheColumnMetadata(stmt_, columnCount_, colNames_, colTypes_);
+  }
 }
 
 /**
@@ -93,7 +104,8 @@ MimerStmtWrapper::MimerStmtWrapper(const Napi::CallbackInfo& info)
  */
 MimerStmtWrapper::~MimerStmtWrapper() {
   if (!closed_ && stmt_ != MIMERNULLHANDLE) {
-    MimerEndStatement(&stmt_);
+    DetachCursor();
+    EndStatement();
     // Unregister from parent if it still exists
     if (parentConnection_) {
       parentConnection_->UnregisterStatement(this);
@@ -113,7 +125,8 @@ void MimerStmtWrapper::SetParentConnection(MimerConnection* conn) {
  */
 void MimerStmtWrapper::Invalidate() {
   if (!closed_ && stmt_ != MIMERNULLHANDLE) {
-    MimerEndStatement(&stmt_);
+    DetachCursor();
+    EndStatement();
   }
   closed_ = true;
   parentConnection_ = nullptr;
@@ -125,7 +138,8 @@ void MimerStmtWrapper::Invalidate() {
  */
 void MimerStmtWrapper::CloseInternal() {
   if (!closed_ && stmt_ != MIMERNULLHANDLE) {
-    MimerEndStatement(&stmt_);
+    DetachCursor();
+    EndStatement();
   }
   closed_ = true;
   if (parentConnection_) {
@@ -134,29 +148,95 @@ void MimerStmtWrapper::CloseInternal() {
   }
 }
 
+void MimerStmtWrapper::CursorClosed(MimerResultSetWrapper* rs) {
+  if (activeCursor_ == rs) {
+    activeCursor_ = nullptr;
+  }
+}
+
+void MimerStmtWrapper::DetachCursor() {
+  if (activeCursor_) {
+    activeCursor_->DetachFromStatement();
+    activeCursor_ = nullptr;
+  }
+}
+
+int MimerStmtWrapper::OpenCursor() {
+  int rc = MimerOpenCursor(stmt_);
+  if (rc >= 0) {
+    CountOperation(ConnectionStats(parentConnection_), STAT_CURSORS_OPENED);
+  }
+  return rc;
+}
+
+void MimerStmtWrapper::EndStatement() {
+  MimerEndStatement(&stmt_);
+  CountOperation(ConnectionStats(parentConnection_), STAT_STATEMENTS_ENDED);
+}
+
+/**
+ * Throw unless the statement can execute: it must be open and must not
+ * have a cursor from executeCursor() still open on its handle.
+ */
+bool MimerStmtWrapper::CheckUsable(Napi::Env env) {
+  if (closed_) {
+    Napi::Error::New(env, "Statement is closed")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  if (activeCursor_) {
+    Napi::Error::New(env, "Statement has an open cursor; close it before executing again")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
 /**
  * Execute the prepared statement with optional parameters.
- * Arguments: params (optional array)
- * Returns: result object with rows and metadata
+ * Arguments: params (optional array),
+ *            options (optional object: maxRows, maxBytes, onLimit, timing)
+ * Returns: result object with rows and metadata; `timing` has no prepare
+ *          time, since the statement was prepared earlier
  */
 Napi::Value MimerStmtWrapper::Execute(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
-  if (closed_) {
-    Napi::Error::New(env, "Statement is closed")
-        .ThrowAsJavaScriptException();
+  if (!CheckUsable(env)) {
+    return env.Undefined();
+  }
+
+  FetchLimits limits;
+  if (parentConnection_) {
+    limits = parentConnection_->GetFetchLimits();
+  }
+  SpillOptions spill;
+  DecodeOptions decode;
+  if (info.Length() >= 2 && (!ParseFetchLimits(env, info[1], limits) ||
+                             !ParseSpillOptions(env, info[1], spill) ||
+                             !ParseDecodeOptions(env, info[1], decode))) {
     return env.Undefined();
   }
+  bool timed = parentConnection_ && parentConnection_->TimingEnabled();
+  if (info.Length() >= 2) {
+    ParseTiming(info[1], timed);
+  }
+  PhaseTiming timing;
+  PhaseTiming* timer = timed ? &timing : nullptr;
+  ScopedStats stats(ConnectionStats(parentConnection_));
 
   // Bind parameters if provided
   if (info.Length() >= 1 && info[0].IsArray()
       && info[0].As<Napi::Array>().Length() > 0) {
     Napi::Array params = info[0].As<Napi::Array>();
-    BindParameters(env, stmt_, params);
+    BindParameters(env, stmt_, params, &stats);
     if (env.IsExceptionPending()) {
       return env.Undefined();
     }
   }
+  if (timer) {
+    timer->Lap(timer->bind);
+  }
 
   bool hasResultSet = (columnCount_ > 0);
   Napi::Object result = Napi::Object::New(env);
@@ -165,20 +245,64 @@ Napi::Value MimerStmtWrapper::Execute(const Napi::CallbackInfo& info) {
   if (hasResultSet) {
     // Build column metadata before fetching rows
     result.Set("fields", BuildFieldsArray(env, stmt_, columnCount_));
+    if (timer) {
+      timer->Lap(timer->convert);
+    }
 
-    rc = MimerOpenCursor(stmt_);
+    rc = OpenCursor();
     if (rc < 0) {
       ThrowMimerError(env, rc, "MimerOpenCursor");
       return env.Undefined();
     }
+    if (timer) {
+      timer->Lap(timer->execute);
+    }
 
-    Napi::Array rows = FetchResults(env, stmt_, columnCount_);
+    bool truncated = false;
+    size_t rowCount = 0;
+    FetchContext context(env, colNames_, colTypes_, decode);
+    context.timing = timer;
+    context.stats = &stats;
+    Napi::Value rows;
+    try {
+      if (spill.enabled) {
+        rows = FetchSpilled(env, stmt_, columnCount_, colNames_, colTypes_,
+                            spill, limits, &truncated, &rowCount);
+        stats.Count(STAT_ROWS_FETCHED, rowCount);
+        if (timer) {
+          timer->Lap(timer->fetch);
+          timer->rows = rowCount;
+        }
+      } else if (decode.Shaped()) {
+        rows = FetchShaped(env, stmt_, columnCount_, colNames_, colTypes_,
+                           limits, &truncated, &context, decode, &rowCount);
+      } else {
+        Napi::Array array = FetchResults(env, stmt_, columnCount_, colNames_, colTypes_,
+                                         limits, &truncated, &context);
+        rowCount = array.Length();
+        rows = array;
+      }
+    } catch (const Napi::Error&) {
+      // JS code run during the fetch (e.g. a rowFactory constructor) threw
+      MimerCloseCursor(stmt_);
+      throw;
+    }
 
-    // Close cursor but keep statement alive for reuse
+    // Close cursor but keep statement alive for reuse (also stops
+    // fetching early when a limit was hit)
     MimerCloseCursor(stmt_);
 
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
     result.Set("rows", rows);
-    result.Set("rowCount", Napi::Number::New(env, rows.Length()));
+    result.Set("rowCount", Napi::Number::New(env, static_cast<double>(rowCount)));
+    if (spill.enabled) {
+      result.Set("spilled", Napi::Boolean::New(env, true));
+    }
+    if (truncated) {
+      result.Set("truncated", Napi::Boolean::New(env, true));
+    }
   } else {
     rc = MimerExecute(stmt_);
     if (rc < 0) {
@@ -186,11 +310,323 @@ Napi::Value MimerStmtWrapper::Execute(const Napi::CallbackInfo& info) {
       return env.Undefined();
     }
     result.Set("rowCount", Napi::Number::New(env, rc));
+    if (timer) {
+      timer->Lap(timer->execute);
+    }
   }
 
+  if (timer) {
+    if (parentConnection_) {
+      parentConnection_->AddTiming(timing);
+    }
+    result.Set("timing", timing.ToObject(env));
+  }
   return result;
 }
 
+/**
+ * Execute the prepared statement once per parameter set in one native call.
+ * Arguments: paramSets (array of parameter arrays), options (optional object)
+ * Returns: { rowCount } summed over all executions, or for queries
+ *          { fields, rowSets, rowCount } (see ExecuteManyQuery)
+ *
+ * Parameter sets are queued with MimerAddBatch and sent in chunks of
+ * EXECUTE_BATCH_CHUNK per MimerExecute, so loading many rows costs a few
+ * round trips instead of one per row.
+ */
+Napi::Value MimerStmtWrapper::ExecuteMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!CheckUsable(env)) {
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Expected an array of parameter arrays")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array sets = info[0].As<Napi::Array>();
+  uint32_t setCount = sets.Length();
+
+  // Validate up front so a bad element cannot leave a half-built batch
+  for (uint32_t i = 0; i < setCount; i++) {
+    if (!sets.Get(i).IsArray()) {
+      Napi::TypeError::New(env, "Expected an array of parameter arrays")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  if (columnCount_ > 0) {
+    return ExecuteManyQuery(env, sets,
+                            info.Length() >= 2 ? info[1] : env.Undefined());
+  }
+
+  double rowCount = 0;
+  uint32_t inBatch = 0;
+  ScopedStats stats(ConnectionStats(parentConnection_));
+
+  for (uint32_t i = 0; i < setCount; i++) {
+    BindParameters(env, stmt_, sets.Get(i).As<Napi::Array>(), &stats);
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+
+    inBatch++;
+    if (i + 1 < setCount && inBatch < EXECUTE_BATCH_CHUNK) {
+      int rc = MimerAddBatch(stmt_);
+      if (rc < 0) {
+        ThrowMimerError(env, rc, "MimerAddBatch");
+        return env.Undefined();
+      }
+      continue;
+    }
+
+    int rc = MimerExecute(stmt_);
+    if (rc < 0) {
+      ThrowMimerError(env, rc, "MimerExecute");
+      return env.Undefined();
+    }
+    rowCount += rc;
+    inBatch = 0;
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("rowCount", Napi::Number::New(env, rowCount));
+  return result;
+}
+
+/**
+ * Run a query once per parameter set, reusing the statement handle and
+ * the column metadata cached at prepare time.
+ * Options: flatten (bool), setIndexColumn (string, default "_set")
+ * Returns: { fields, rowSets, rowCount } with one row array per set, or
+ *          with flatten { fields, rows, rowCount } where every row carries
+ *          the index of its parameter set in setIndexColumn.
+ */
+Napi::Value MimerStmtWrapper::ExecuteManyQuery(Napi::Env env, Napi::Array sets,
+                                               Napi::Value options) {
+  bool flatten = false;
+  std::string setIndexColumn = "_set";
+  if (options.IsObject()) {
+    Napi::Object opts = options.As<Napi::Object>();
+    flatten = opts.Get("flatten").ToBoolean().Value();
+    Napi::Value col = opts.Get("setIndexColumn");
+    if (col.IsString()) {
+      setIndexColumn = col.As<Napi::String>().Utf8Value();
+    }
+  }
+
+  uint32_t setCount = sets.Length();
+  Napi::Array rows = Napi::Array::New(env);
+  Napi::Array rowSets = Napi::Array::New(env);
+  uint32_t rowIndex = 0;
+  int rc;
+  ScopedStats stats(ConnectionStats(parentConnection_));
+  FetchContext context(env, colNames_, colTypes_, DecodeOptions());
+  context.stats = &stats;
+
+  for (uint32_t i = 0; i < setCount; i++) {
+    Napi::Array params = sets.Get(i).As<Napi::Array>();
+    if (params.Length() > 0) {
+      BindParameters(env, stmt_, params, &stats);
+      if (env.IsExceptionPending()) {
+        return env.Undefined();
+      }
+    }
+
+    rc = OpenCursor();
+    if (rc < 0) {
+      ThrowMimerError(env, rc, "MimerOpenCursor");
+      return env.Undefined();
+    }
+
+    if (flatten) {
+      Napi::Number setIndex = Napi::Number::New(env, i);
+      while (MimerFetch(stmt_) == MIMER_SUCCESS) {
+        Napi::Object row = FetchSingleRow(env, stmt_, columnCount_, colNames_, colTypes_,
+                                          nullptr, &context);
+        row.Set(setIndexColumn, setIndex);
+        rows.Set(rowIndex++, row);
+        stats.Count(STAT_ROWS_FETCHED);
+      }
+    } else {
+      Napi::Array setRows = FetchResults(env, stmt_, columnCount_, colNames_, colTypes_,
+                                         FetchLimits(), nullptr, &context);
+      rowIndex += setRows.Length();
+      rowSets.Set(i, setRows);
+    }
+
+    MimerCloseCursor(stmt_);
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("fields", BuildFieldsArray(env, stmt_, columnCount_));
+  result.Set(flatten ? "rows" : "rowSets", flatten ? rows : rowSets);
+  result.Set("rowCount", Napi::Number::New(env, rowIndex));
+  return result;
+}
+
+/**
+ * Execute the prepared query and return only the rows that changed since
+ * the previous executeDiff() call on this statement.
+ * Arguments: params (array, may be empty), keyColumn (string)
+ * Returns: { inserted, updated, deleted, rowCount }
+ *
+ * Rows are read into native cells and hashed without creating JS values;
+ * only inserted and updated rows are materialized. `deleted` holds the
+ * key values of rows that are no longer present. The first call reports
+ * every row as inserted. Key values must be unique within the result.
+ */
+Napi::Value MimerStmtWrapper::ExecuteDiff(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!CheckUsable(env)) {
+    return env.Undefined();
+  }
+
+  if (columnCount_ <= 0) {
+    Napi::Error::New(env, "executeDiff() requires a statement that returns a result set")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 2 || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Expected key column name as second argument")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string keyName = info[1].As<Napi::String>().Utf8Value();
+  int keyIndex = -1;
+  for (int i = 0; i < columnCount_; i++) {
+    if (colNames_[i] == keyName) {
+      keyIndex = i;
+      break;
+    }
+  }
+  if (keyIndex < 0) {
+    Napi::Error::New(env, "Key column '" + keyName + "' is not in the result set")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  ScopedStats stats(ConnectionStats(parentConnection_));
+  if (info[0].IsArray() && info[0].As<Napi::Array>().Length() > 0) {
+    BindParameters(env, stmt_, info[0].As<Napi::Array>(), &stats);
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+  }
+
+  int rc = OpenCursor();
+  if (rc < 0) {
+    ThrowMimerError(env, rc, "MimerOpenCursor");
+    return env.Undefined();
+  }
+
+  Napi::Array inserted = Napi::Array::New(env);
+  Napi::Array updated = Napi::Array::New(env);
+  Napi::Array deleted = Napi::Array::New(env);
+  uint32_t insertedCount = 0, updatedCount = 0, deletedCount = 0;
+
+  std::unordered_map<std::string, DiffEntry> next;
+  next.reserve(diffSnapshot_.size());
+  std::vector<RawCell> cells;
+  double rowCount = 0;
+
+  while ((rc = MimerFetch(stmt_)) == MIMER_SUCCESS) {
+    ReadRawRow(stmt_, columnCount_, colTypes_, cells);
+    uint64_t hash = HashRawRow(cells);
+    std::string key = RawCellKey(cells[keyIndex]);
+    rowCount++;
+    stats.Count(STAT_ROWS_FETCHED);
+
+    auto prev = diffSnapshot_.find(key);
+    if (prev == diffSnapshot_.end()) {
+      inserted.Set(insertedCount++, RawRowToObject(env, cells, colNames_));
+    } else if (prev->second.hash != hash) {
+      updated.Set(updatedCount++, RawRowToObject(env, cells, colNames_));
+    }
+    next[key] = DiffEntry{hash, cells[keyIndex]};
+  }
+
+  MimerCloseCursor(stmt_);
+
+  // A failed fetch keeps the previous snapshot so the next call diffs
+  // against the last complete result
+  if (rc < 0) {
+    ThrowMimerError(env, rc, "MimerFetch");
+    return env.Undefined();
+  }
+
+  for (const auto& entry : diffSnapshot_) {
+    if (next.find(entry.first) == next.end()) {
+      deleted.Set(deletedCount++, RawCellToValue(env, entry.second.key));
+    }
+  }
+  diffSnapshot_.swap(next);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("inserted", inserted);
+  result.Set("updated", updated);
+  result.Set("deleted", deleted);
+  result.Set("rowCount", Napi::Number::New(env, rowCount));
+  return result;
+}
+
+/**
+ * Bind parameters and open a cursor on the prepared handle.
+ * Arguments: params (optional array)
+ * Returns: MimerResultSetWrapper (native object)
+ *
+ * The result set borrows the statement handle: closing it closes only the
+ * cursor, and the statement can then be executed again. Closing the
+ * statement closes an open cursor first.
+ */
+Napi::Value MimerStmtWrapper::ExecuteCursor(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!CheckUsable(env)) {
+    return env.Undefined();
+  }
+
+  if (columnCount_ <= 0) {
+    Napi::Error::New(env, "executeCursor() requires a statement that returns a result set")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() >= 1 && info[0].IsArray()
+      && info[0].As<Napi::Array>().Length() > 0) {
+    ScopedStats stats(ConnectionStats(parentConnection_));
+    BindParameters(env, stmt_, info[0].As<Napi::Array>(), &stats);
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+  }
+
+  int rc = OpenCursor();
+  if (rc < 0) {
+    ThrowMimerError(env, rc, "MimerOpenCursor");
+    return env.Undefined();
+  }
+
+  Napi::Object rsObj = MimerResultSetWrapper::NewInstance(env, stmt_, columnCount_, Value());
+  if (env.IsExceptionPending()) {
+    MimerCloseCursor(stmt_);
+    return env.Undefined();
+  }
+  activeCursor_ = MimerResultSetWrapper::Unwrap(rsObj);
+  // Not registered: the statement owns the cursor and detaches it before
+  // the connection goes away. The link is only for fetch statistics.
+  activeCursor_->SetParentConnection(parentConnection_);
+
+  return rsObj;
+}
+
 /**
  * Close the prepared statement and release its handle.
  */
@@ -25,8 +25,13 @@
 
 #include <napi.h>
 #include <mimerapi.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "helpers.h"
 
 class MimerConnection; // forward declaration
+class MimerResultSetWrapper; // forward declaration
 
 /**
  * MimerStmtWrapper wraps a Mimer prepared statement for reuse.
@@ -55,16 +60,51 @@ public:
   // without the statement trying to unregister from the connection
   void Invalidate();
 
+  // Called by a result set from executeCursor() when its cursor is closed
+  void CursorClosed(MimerResultSetWrapper* rs);
+
 private:
   MimerStatement stmt_;
   int columnCount_;
   bool closed_;
   MimerConnection* parentConnection_;
 
+  // Result set from executeCursor() whose cursor is open on stmt_
+  MimerResultSetWrapper* activeCursor_;
+
+  // Column metadata cached at prepare time (SELECT statements only)
+  std::vector<std::string> colNames_;
+  std::vector<int> colTypes_;
+
+  // Previous executeDiff() result: encoded key value -> row hash
+  struct DiffEntry {
+    uint64_t hash;
+    RawCell key;
+  };
+  std::unordered_map<std::string, DiffEntry> diffSnapshot_;
+
   // Methods exposed to JavaScript
   Napi::Value Execute(const Napi::CallbackInfo& info);
+  Napi::Value ExecuteMany(const Napi::CallbackInfo& info);
+  Napi::Value ExecuteDiff(const Napi::CallbackInfo& info);
+  Napi::Value ExecuteCursor(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
 
+  // executeMany() for statements that return a result set
+  Napi::Value ExecuteManyQuery(Napi::Env env, Napi::Array sets,
+                               Napi::Value options);
+
+  // Throws if the statement is closed or has a cursor open
+  bool CheckUsable(Napi::Env env);
+
+  // Close an open executeCursor() result set before the handle goes away
+  void DetachCursor();
+
+  // MimerOpenCursor / MimerEndStatement on stmt_, counted in the
+  // connection's stats
+  int OpenCursor();
+  void EndStatement();
+
   // Internal close logic shared by Close() and destructor
   void CloseInternal();
 
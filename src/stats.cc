@@ -0,0 +1,311 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+#include "stats.h"
+#include "helpers.h"
+#include <algorithm>
+#include <atomic>
+
+// Process-wide totals; connections on worker threads add to them too
+static std::atomic<uint64_t> globalCounts[STAT_COUNT];
+
+void OperationStats::CountCell(int colType, bool isNull, size_t size) {
+  if (isNull) {
+    counts[STAT_CELLS_NULL]++;
+  } else if (MimerIsInt32(colType) || MimerIsInt64(colType)) {
+    counts[STAT_CELLS_INTEGER]++;
+  } else if (MimerIsDouble(colType) || MimerIsFloat(colType)) {
+    counts[STAT_CELLS_FLOAT]++;
+  } else if (MimerIsBoolean(colType)) {
+    counts[STAT_CELLS_BOOLEAN]++;
+  } else if (MimerIsBlob(colType) || MimerIsNclob(colType)) {
+    counts[STAT_CELLS_LOB]++;
+    counts[STAT_LOB_BYTES] += size;
+  } else if (MimerIsBinary(colType)) {
+    counts[STAT_CELLS_BINARY]++;
+    counts[STAT_BUFFER_BYTES] += size;
+  } else if (IsCharacterType(colType)) {
+    counts[STAT_CELLS_STRING]++;
+    counts[STAT_STRING_BYTES] += size;
+  } else {
+    counts[STAT_CELLS_OTHER]++;
+    counts[STAT_STRING_BYTES] += size;
+  }
+}
+
+static Napi::Object CounterGroup(Napi::Env env, const uint64_t* counts,
+                                 const char* const* names, int first, int count) {
+  Napi::Object group = Napi::Object::New(env);
+  for (int i = 0; i < count; i++) {
+    group.Set(names[i], Napi::Number::New(env, static_cast<double>(counts[first + i])));
+  }
+  return group;
+}
+
+static Napi::Object StatsObject(Napi::Env env, const uint64_t* counts) {
+  static const char* const cellNames[] = {
+    "null", "integer", "float", "boolean", "string", "binary", "lob", "other",
+  };
+  static const char* const byteNames[] = { "string", "buffer", "lob" };
+  static const char* const bindNames[] = {
+    "null", "boolean", "integer", "double", "string", "buffer", "lob", "other",
+  };
+
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("statementsPrepared",
+          Napi::Number::New(env, static_cast<double>(counts[STAT_STATEMENTS_PREPARED])));
+  obj.Set("statementsEnded",
+          Napi::Number::New(env, static_cast<double>(counts[STAT_STATEMENTS_ENDED])));
+  obj.Set("cursorsOpened",
+          Napi::Number::New(env, static_cast<double>(counts[STAT_CURSORS_OPENED])));
+  obj.Set("rowsFetched",
+          Napi::Number::New(env, static_cast<double>(counts[STAT_ROWS_FETCHED])));
+  obj.Set("cells", CounterGroup(env, counts, cellNames, STAT_CELLS_NULL, 8));
+  obj.Set("bytes", CounterGroup(env, counts, byteNames, STAT_STRING_BYTES, 3));
+  obj.Set("binds", CounterGroup(env, counts, bindNames, STAT_BINDS_NULL, 8));
+  return obj;
+}
+
+Napi::Object OperationStats::ToObject(Napi::Env env) const {
+  return StatsObject(env, counts);
+}
+
+void AddOperationStats(OperationStats* target, const OperationStats& delta) {
+  for (int i = 0; i < STAT_COUNT; i++) {
+    if (delta.counts[i] == 0) {
+      continue;
+    }
+    if (target) {
+      target->counts[i] += delta.counts[i];
+    }
+    globalCounts[i].fetch_add(delta.counts[i], std::memory_order_relaxed);
+  }
+}
+
+void CountOperation(OperationStats* target, StatCounter counter, uint64_t n) {
+  if (target) {
+    target->counts[counter] += n;
+  }
+  globalCounts[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+Napi::Value GetGlobalStats(const Napi::CallbackInfo& info) {
+  uint64_t counts[STAT_COUNT];
+  for (int i = 0; i < STAT_COUNT; i++) {
+    counts[i] = globalCounts[i].load(std::memory_order_relaxed);
+  }
+  return StatsObject(info.Env(), counts);
+}
+
+const double LATENCY_BUCKET_BOUNDS[LATENCY_BUCKETS - 1] = {
+  0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 10000,
+};
+
+StatementStatsTable& StatementStatsTable::Instance() {
+  static StatementStatsTable table;
+  return table;
+}
+
+void StatementStatsTable::Record(const std::string& fingerprint, double ms,
+                                 uint64_t rows, bool failed) {
+  int bucket = 0;
+  while (bucket < LATENCY_BUCKETS - 1 && ms > LATENCY_BUCKET_BOUNDS[bucket]) {
+    bucket++;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(fingerprint);
+  if (it == entries_.end()) {
+    if (entries_.size() >= maxEntries_) {
+      EvictLeastCalled();
+    }
+    it = entries_.emplace(fingerprint, Entry()).first;
+  }
+  Entry& entry = it->second;
+  entry.calls++;
+  if (failed) {
+    entry.errors++;
+  }
+  entry.rows += rows;
+  entry.totalMs += ms;
+  if (ms > entry.maxMs) {
+    entry.maxMs = ms;
+  }
+  entry.histogram[bucket]++;
+}
+
+/**
+ * Drop the 5% of entries (at least one) with the fewest calls.
+ */
+void StatementStatsTable::EvictLeastCalled() {
+  if (entries_.empty()) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, const std::string*>> byCalls;
+  byCalls.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    byCalls.emplace_back(entry.second.calls, &entry.first);
+  }
+  size_t count = std::max<size_t>(1, entries_.size() / 20);
+  std::nth_element(byCalls.begin(), byCalls.begin() + (count - 1), byCalls.end());
+  std::vector<std::string> victims;
+  victims.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    victims.push_back(*byCalls[i].second);
+  }
+  for (const std::string& key : victims) {
+    entries_.erase(key);
+  }
+}
+
+void StatementStatsTable::SetMaxEntries(size_t maxEntries) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  maxEntries_ = maxEntries > 0 ? maxEntries : 1;
+  while (entries_.size() > maxEntries_) {
+    EvictLeastCalled();
+  }
+}
+
+void StatementStatsTable::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+static double SortKey(const StatementStatsTable::Entry& entry, const std::string& orderBy) {
+  if (orderBy == "calls") return static_cast<double>(entry.calls);
+  if (orderBy == "rows") return static_cast<double>(entry.rows);
+  if (orderBy == "maxTime") return entry.maxMs;
+  if (orderBy == "meanTime") return entry.calls ? entry.totalMs / entry.calls : 0;
+  return entry.totalMs;
+}
+
+std::vector<std::pair<std::string, StatementStatsTable::Entry>>
+StatementStatsTable::Top(const std::string& orderBy, size_t limit) {
+  std::vector<std::pair<std::string, Entry>> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.assign(entries_.begin(), entries_.end());
+  }
+  auto greater = [&orderBy](const std::pair<std::string, Entry>& a,
+                            const std::pair<std::string, Entry>& b) {
+    return SortKey(a.second, orderBy) > SortKey(b.second, orderBy);
+  };
+  if (limit > 0 && limit < result.size()) {
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(), greater);
+    result.resize(limit);
+  } else {
+    std::sort(result.begin(), result.end(), greater);
+  }
+  return result;
+}
+
+Napi::Value RecordStatement(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected fingerprint and latency")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  double rows = info.Length() >= 3 && info[2].IsNumber()
+      ? info[2].As<Napi::Number>().DoubleValue() : 0;
+  bool failed = info.Length() >= 4 && info[3].ToBoolean().Value();
+  StatementStatsTable::Instance().Record(
+      info[0].As<Napi::String>().Utf8Value(),
+      info[1].As<Napi::Number>().DoubleValue(),
+      rows > 0 ? static_cast<uint64_t>(rows) : 0, failed);
+  return env.Undefined();
+}
+
+Napi::Value GetStatementStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  size_t limit = 20;
+  std::string orderBy = "totalTime";
+  if (info.Length() >= 1 && info[0].IsObject()) {
+    Napi::Object opts = info[0].As<Napi::Object>();
+    Napi::Value value = opts.Get("limit");
+    if (value.IsNumber()) {
+      double n = value.As<Napi::Number>().DoubleValue();
+      limit = n > 0 ? static_cast<size_t>(n) : 0;
+    }
+    value = opts.Get("orderBy");
+    if (value.IsString()) {
+      orderBy = value.As<Napi::String>().Utf8Value();
+      if (orderBy != "totalTime" && orderBy != "meanTime" && orderBy != "maxTime" &&
+          orderBy != "calls" && orderBy != "rows") {
+        Napi::TypeError::New(env, "orderBy must be totalTime, meanTime, maxTime, calls or rows")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+    }
+  }
+
+  auto top = StatementStatsTable::Instance().Top(orderBy, limit);
+  Napi::Array result = Napi::Array::New(env, top.size());
+  for (size_t i = 0; i < top.size(); i++) {
+    const StatementStatsTable::Entry& entry = top[i].second;
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("fingerprint", Napi::String::New(env, top[i].first));
+    obj.Set("calls", Napi::Number::New(env, static_cast<double>(entry.calls)));
+    obj.Set("errors", Napi::Number::New(env, static_cast<double>(entry.errors)));
+    obj.Set("rows", Napi::Number::New(env, static_cast<double>(entry.rows)));
+    obj.Set("totalTime", Napi::Number::New(env, entry.totalMs));
+    obj.Set("meanTime", Napi::Number::New(env, entry.calls ? entry.totalMs / entry.calls : 0));
+    obj.Set("maxTime", Napi::Number::New(env, entry.maxMs));
+    Napi::Array histogram = Napi::Array::New(env, LATENCY_BUCKETS);
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+      histogram.Set(b, Napi::Number::New(env, static_cast<double>(entry.histogram[b])));
+    }
+    obj.Set("histogram", histogram);
+    result.Set(static_cast<uint32_t>(i), obj);
+  }
+  return result;
+}
+
+Napi::Value ResetStatementStats(const Napi::CallbackInfo& info) {
+  StatementStatsTable::Instance().Reset();
+  return info.Env().Undefined();
+}
+
+Napi::Value ConfigureStatementStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() >= 1 && info[0].IsObject()) {
+    Napi::Value maxEntries = info[0].As<Napi::Object>().Get("maxEntries");
+    if (!maxEntries.IsUndefined()) {
+      if (!maxEntries.IsNumber() || maxEntries.As<Napi::Number>().DoubleValue() < 1) {
+        Napi::TypeError::New(env, "maxEntries must be a positive number")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      StatementStatsTable::Instance().SetMaxEntries(
+          static_cast<size_t>(maxEntries.As<Napi::Number>().DoubleValue()));
+    }
+  }
+  return env.Undefined();
+}
+
+Napi::Array LatencyBucketBounds(Napi::Env env) {
+  Napi::Array bounds = Napi::Array::New(env, LATENCY_BUCKETS - 1);
+  for (int b = 0; b < LATENCY_BUCKETS - 1; b++) {
+    bounds.Set(b, Napi::Number::New(env, LATENCY_BUCKET_BOUNDS[b]));
+  }
+  return bounds;
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Mimer Information Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// See license for more details.
+
+#ifndef MIMER_STATS_H
+#define MIMER_STATS_H
+
+#include <napi.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Operation counters kept per connection and for the whole process.
+ * Cells are counted by the JS type they decode to; "other" covers the
+ * values returned as strings (DECIMAL, date/time, UUID, INTERVAL). Byte
+ * counters are the sizes of the strings, Buffers and LOB values produced.
+ */
+enum StatCounter {
+  STAT_STATEMENTS_PREPARED,
+  STAT_STATEMENTS_ENDED,
+  STAT_CURSORS_OPENED,
+  STAT_ROWS_FETCHED,
+  STAT_CELLS_NULL,
+  STAT_CELLS_INTEGER,
+  STAT_CELLS_FLOAT,
+  STAT_CELLS_BOOLEAN,
+  STAT_CELLS_STRING,
+  STAT_CELLS_BINARY,
+  STAT_CELLS_LOB,
+  STAT_CELLS_OTHER,
+  STAT_STRING_BYTES,
+  STAT_BUFFER_BYTES,
+  STAT_LOB_BYTES,
+  STAT_BINDS_NULL,
+  STAT_BINDS_BOOLEAN,
+  STAT_BINDS_INTEGER,
+  STAT_BINDS_DOUBLE,
+  STAT_BINDS_STRING,
+  STAT_BINDS_BUFFER,
+  STAT_BINDS_LOB,
+  STAT_BINDS_OTHER,
+  STAT_COUNT
+};
+
+/**
+ * A set of counters. Hot paths count into a local OperationStats and hand
+ * it to AddOperationStats() once per call, so the shared process-wide
+ * counters (atomics) are touched once per counter per call, not per cell.
+ */
+struct OperationStats {
+  uint64_t counts[STAT_COUNT] = {};
+
+  void Count(StatCounter counter, uint64_t n = 1) { counts[counter] += n; }
+
+  /**
+   * Count one decoded cell of Mimer type `colType`; `size` is the byte
+   * length of a string, Buffer or LOB value.
+   */
+  void CountCell(int colType, bool isNull, size_t size);
+
+  Napi::Object ToObject(Napi::Env env) const;
+};
+
+/**
+ * Add `delta` to `target` (when not null) and to the process-wide counters.
+ */
+void AddOperationStats(OperationStats* target, const OperationStats& delta);
+
+/**
+ * Add `n` to one counter of `target` (when not null) and of the process.
+ */
+void CountOperation(OperationStats* target, StatCounter counter, uint64_t n = 1);
+
+/**
+ * Counters for one call, added to `target` and the process totals when
+ * the call returns, whichever path it returns by.
+ */
+class ScopedStats : public OperationStats {
+public:
+  explicit ScopedStats(OperationStats* target) : target_(target) {}
+  ~ScopedStats() { AddOperationStats(target_, *this); }
+  ScopedStats(const ScopedStats&) = delete;
+  ScopedStats& operator=(const ScopedStats&) = delete;
+
+private:
+  OperationStats* target_;
+};
+
+/**
+ * JS: getStats() — the process-wide counters, as returned by
+ * Connection.getStats().
+ */
+Napi::Value GetGlobalStats(const Napi::CallbackInfo& info);
+
+/**
+ * Latency histogram bucket upper bounds in milliseconds; the last bucket
+ * (no bound) holds everything slower.
+ */
+constexpr int LATENCY_BUCKETS = 16;
+extern const double LATENCY_BUCKET_BOUNDS[LATENCY_BUCKETS - 1];
+
+/**
+ * Process-wide per-fingerprint statement statistics, the client-side
+ * counterpart of pg_stat_statements. The JS layer records one entry per
+ * call: the normalized SQL, its latency, the rows returned and whether it
+ * failed. The table holds at most maxEntries fingerprints; when it is full
+ * the least-called 5% are dropped to make room.
+ */
+class StatementStatsTable {
+public:
+  struct Entry {
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t rows = 0;
+    double totalMs = 0;
+    double maxMs = 0;
+    uint64_t histogram[LATENCY_BUCKETS] = {};
+  };
+
+  static StatementStatsTable& Instance();
+
+  void Record(const std::string& fingerprint, double ms, uint64_t rows, bool failed);
+  void SetMaxEntries(size_t maxEntries);
+  void Reset();
+
+  // Entries ordered by `orderBy` (descending), at most `limit` (0 = all)
+  std::vector<std::pair<std::string, Entry>> Top(const std::string& orderBy,
+                                                 size_t limit);
+
+private:
+  void EvictLeastCalled();
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  size_t maxEntries_ = 5000;
+};
+
+/**
+ * JS: recordStatement(fingerprint, ms, rows, failed)
+ */
+Napi::Value RecordStatement(const Napi::CallbackInfo& info);
+
+/**
+ * JS: getStatementStats({ limit = 20, orderBy = 'totalTime' }) — entries
+ * { fingerprint, calls, errors, rows, totalTime, meanTime, maxTime,
+ * histogram }; orderBy is totalTime, meanTime, maxTime, calls or rows.
+ */
+Napi::Value GetStatementStats(const Napi::CallbackInfo& info);
+
+/**
+ * JS: resetStatementStats()
+ */
+Napi::Value ResetStatementStats(const Napi::CallbackInfo& info);
+
+/**
+ * JS: configureStatementStats({ maxEntries })
+ */
+Napi::Value ConfigureStatementStats(const Napi::CallbackInfo& info);
+
+/**
+ * Array of LATENCY_BUCKET_BOUNDS, exported as statementLatencyBuckets.
+ */
+Napi::Array LatencyBucketBounds(Napi::Env env);
+
+#endif // MIMER_STATS_H
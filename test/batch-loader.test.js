@@ -0,0 +1,102 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('batch loader', () => {
+  let client;
+  const TABLE = 'test_batch_loader';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, parent INTEGER, name NVARCHAR(100))`
+    );
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`);
+    for (let i = 1; i <= 20; i++) {
+      await stmt.execute([i, i % 3, `row${i}`]);
+    }
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('coalesces same-tick loads and scatters rows by key', async () => {
+    const loader = client.batchLoader(`SELECT id, name FROM ${TABLE} WHERE id IN (?)`);
+    try {
+      const [a, b, c, missing] = await Promise.all([
+        loader.load(3), loader.load(1), loader.load(3), loader.load(999),
+      ]);
+      assert.strictEqual(a.name, 'row3');
+      assert.strictEqual(b.name, 'row1');
+      assert.strictEqual(c, a);
+      assert.strictEqual(missing, null);
+    } finally {
+      await loader.close();
+    }
+  });
+
+  it('splits large batches by maxBatch', async () => {
+    const loader = client.batchLoader(
+      `SELECT id, name FROM ${TABLE} WHERE id IN (?)`, { maxBatch: 4 }
+    );
+    try {
+      const keys = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10];
+      const rows = await loader.loadMany(keys);
+      assert.deepStrictEqual(rows.map((r) => r.id), keys);
+    } finally {
+      await loader.close();
+    }
+  });
+
+  it('many option resolves arrays of rows', async () => {
+    const loader = client.batchLoader(
+      `SELECT id, parent FROM ${TABLE} WHERE parent IN (?) ORDER BY id`, { many: true }
+    );
+    try {
+      const [zero, one, none] = await loader.loadMany([0, 1, 7]);
+      assert.deepStrictEqual(zero.map((r) => r.id), [3, 6, 9, 12, 15, 18]);
+      assert.strictEqual(one.length, 7);
+      assert.deepStrictEqual(none, []);
+    } finally {
+      await loader.close();
+    }
+  });
+
+  it('rejects templates without an IN (?) placeholder', () => {
+    assert.throws(
+      () => client.batchLoader(`SELECT * FROM ${TABLE} WHERE id = ?`),
+      { message: /IN \(\?\)/ }
+    );
+  });
+
+  it('rejects NOT IN templates', () => {
+    assert.throws(
+      () => client.batchLoader(`SELECT * FROM ${TABLE} WHERE id NOT IN (?)`),
+      { message: /IN \(\?\)/ }
+    );
+  });
+
+  it('matches keys of another type by value', async () => {
+    const loader = client.batchLoader(`SELECT id, name FROM ${TABLE} WHERE id IN (?)`);
+    try {
+      const [a, b, c] = await Promise.all([
+        loader.load('5'), loader.load(5), loader.load('6'),
+      ]);
+      assert.strictEqual(a.name, 'row5');
+      assert.strictEqual(b, a);
+      assert.strictEqual(c.name, 'row6');
+    } finally {
+      await loader.close();
+    }
+  });
+
+  it('load after close rejects', async () => {
+    const loader = client.batchLoader(`SELECT id FROM ${TABLE} WHERE id IN (?)`);
+    await loader.close();
+    await assert.rejects(() => loader.load(1), { message: /closed/ });
+  });
+});
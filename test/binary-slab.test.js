@@ -0,0 +1,88 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('binary slab', () => {
+  let client;
+  const TABLE = 'test_binary_slab';
+
+  function digest(i) {
+    const buf = Buffer.alloc(32);
+    buf.writeUInt32BE(i, 0);
+    buf.fill(i & 0xff, 4);
+    return buf;
+  }
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, digest VARBINARY(64), tag BINARY(4))`);
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`);
+    const sets = [];
+    for (let i = 1; i <= 40; i++) {
+      sets.push([i, i % 10 === 0 ? null : digest(i), Buffer.from([i, 0, 0, i])]);
+    }
+    await stmt.executeMany(sets);
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('returns views into one shared ArrayBuffer', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} ORDER BY id`, [], { binarySlab: true }
+    );
+    assert.strictEqual(result.rows.length, 40);
+
+    const first = result.rows[0].digest;
+    assert.ok(first instanceof Uint8Array);
+    assert.strictEqual(first.byteLength, 32);
+    assert.strictEqual(result.rows[1].digest.buffer, first.buffer);
+    assert.strictEqual(result.rows[1].tag.buffer, first.buffer);
+
+    for (const row of result.rows) {
+      if (row.id % 10 === 0) {
+        assert.strictEqual(row.digest, null);
+      } else {
+        assert.deepStrictEqual(Buffer.from(row.digest), digest(row.id));
+      }
+      assert.deepStrictEqual(Buffer.from(row.tag), Buffer.from([row.id, 0, 0, row.id]));
+    }
+  });
+
+  it('keeps column order', async () => {
+    const result = await client.query(
+      `SELECT digest, id, tag FROM ${TABLE} WHERE id = 1`, [], { binarySlab: true }
+    );
+    assert.deepStrictEqual(Object.keys(result.rows[0]), ['digest', 'id', 'tag']);
+  });
+
+  it('works with prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT digest FROM ${TABLE} WHERE id = ?`);
+    const result = await stmt.execute([3], { binarySlab: true });
+    assert.deepStrictEqual(Buffer.from(result.rows[0].digest), digest(3));
+    await stmt.close();
+  });
+
+  it('returns Buffers without the option', async () => {
+    const result = await client.query(`SELECT digest FROM ${TABLE} WHERE id = 1`);
+    assert.ok(Buffer.isBuffer(result.rows[0].digest));
+  });
+
+  it('does not serve slab views to plain queries from the cache', async () => {
+    const cached = await createClient({ cache: true });
+    try {
+      const sql = `SELECT digest FROM ${TABLE} WHERE id = ?`;
+      const slab = await cached.query(sql, [4], { binarySlab: true });
+      assert.ok(!Buffer.isBuffer(slab.rows[0].digest));
+      const plain = await cached.query(sql, [4]);
+      assert.ok(Buffer.isBuffer(plain.rows[0].digest));
+      assert.strictEqual(cached.cacheStats().hits, 0);
+    } finally {
+      await cached.close();
+    }
+  });
+});
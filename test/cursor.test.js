@@ -164,4 +164,75 @@ describe('cursor / streaming results', () => {
     // close() should be safe
     await cursor.close();
   });
+
+  it('executeCursor reuses a prepared statement', async () => {
+    const stmt = await client.prepare(
+      `SELECT id FROM ${TABLE} WHERE id <= ? ORDER BY id`
+    );
+
+    const first = [];
+    for await (const row of await stmt.executeCursor([3])) {
+      first.push(row.id);
+    }
+    assert.deepStrictEqual(first, [1, 2, 3]);
+
+    // Statement is still usable after the cursor is exhausted
+    const second = await stmt.executeCursor([2]);
+    assert.strictEqual(second.fields[0].name, 'id');
+    assert.strictEqual((await second.next()).id, 1);
+    await second.close();
+
+    const result = await stmt.execute([1]);
+    assert.strictEqual(result.rowCount, 1);
+    await stmt.close();
+  });
+
+  it('executeCursor rejects a second open cursor on the same statement', async () => {
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} ORDER BY id`);
+    const cursor = await stmt.executeCursor();
+    await assert.rejects(() => stmt.executeCursor(), /open cursor/);
+    await assert.rejects(() => stmt.execute(), /open cursor/);
+    await cursor.close();
+    await stmt.close();
+  });
+
+  it('closing the statement closes its cursor', async () => {
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} ORDER BY id`);
+    const cursor = await stmt.executeCursor();
+    assert.strictEqual((await cursor.next()).id, 1);
+    await stmt.close();
+    assert.strictEqual(await cursor.next(), null);
+    await cursor.close();
+  });
+
+  it('reuseRow overwrites one row object per fetch', async () => {
+    const cursor = await client.queryCursor(
+      `SELECT id, name FROM ${TABLE} ORDER BY id`, [], { reuseRow: true }
+    );
+    const first = await cursor.next();
+    assert.deepStrictEqual({ ...first }, { id: 1, name: 'row1' });
+    const second = await cursor.next();
+    assert.strictEqual(second, first);
+    assert.deepStrictEqual({ ...second }, { id: 2, name: 'row2' });
+
+    const ids = [];
+    for await (const row of cursor) {
+      ids.push(row.id);
+    }
+    assert.deepStrictEqual(ids, [3, 4, 5, 6, 7, 8, 9, 10]);
+  });
+
+  it('reuseRow works with executeCursor', async () => {
+    const stmt = await client.prepare(`SELECT id, name FROM ${TABLE} WHERE id <= ? ORDER BY id`);
+    const cursor = await stmt.executeCursor([3], { reuseRow: true });
+    const seen = new Set();
+    let count = 0;
+    for await (const row of cursor) {
+      seen.add(row);
+      count++;
+    }
+    assert.strictEqual(count, 3);
+    assert.strictEqual(seen.size, 1);
+    await stmt.close();
+  });
 });
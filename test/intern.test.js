@@ -0,0 +1,72 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('string interning', () => {
+  let client;
+  const TABLE = 'test_intern';
+  const STATUSES = ['new', 'paid', 'shipped'];
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, status VARCHAR(20), note NVARCHAR(50))`);
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`);
+    const sets = [];
+    for (let i = 1; i <= 30; i++) {
+      sets.push([i, STATUSES[i % 3], i % 5 === 0 ? null : `note ${i} ö`]);
+    }
+    await stmt.executeMany(sets);
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('returns the same values as a plain query', async () => {
+    const sql = `SELECT * FROM ${TABLE} ORDER BY id`;
+    const plain = await client.query(sql);
+    const interned = await client.query(sql, [], { intern: true });
+    assert.deepStrictEqual(interned.rows, plain.rows);
+  });
+
+  it('interns only the named columns', async () => {
+    const result = await client.query(
+      `SELECT id, status, note FROM ${TABLE} ORDER BY id`, [], { intern: ['status'] }
+    );
+    assert.strictEqual(result.rows.length, 30);
+    assert.strictEqual(result.rows[0].status, 'paid');
+    assert.strictEqual(result.rows[4].note, null);
+    assert.strictEqual(result.rows[5].note, 'note 6 ö');
+  });
+
+  it('falls back when a column exceeds internLimit', async () => {
+    const result = await client.query(
+      `SELECT id, note FROM ${TABLE} ORDER BY id`, [], { intern: true, internLimit: 2 }
+    );
+    const notes = result.rows.map((r) => r.note);
+    assert.strictEqual(notes[0], 'note 1 ö');
+    assert.strictEqual(notes[29], null);
+    assert.strictEqual(notes[28], 'note 29 ö');
+  });
+
+  it('works with prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT status FROM ${TABLE} WHERE id <= ? ORDER BY id`);
+    const result = await stmt.execute([3], { intern: true });
+    assert.deepStrictEqual(result.rows.map((r) => r.status), ['paid', 'shipped', 'new']);
+    await stmt.close();
+  });
+
+  it('rejects invalid options', async () => {
+    await assert.rejects(
+      () => client.query(`SELECT * FROM ${TABLE}`, [], { intern: 'status' }),
+      TypeError
+    );
+    await assert.rejects(
+      () => client.query(`SELECT * FROM ${TABLE}`, [], { intern: true, internLimit: 0 }),
+      TypeError
+    );
+  });
+});
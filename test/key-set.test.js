@@ -0,0 +1,94 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('key sets and batched execution', () => {
+  let client;
+  const TABLE = 'test_key_set';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(100))`
+    );
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('executeMany() inserts every parameter set', async () => {
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?)`);
+    const sets = [];
+    for (let i = 1; i <= 2500; i++) {
+      sets.push([i, `row${i}`]);
+    }
+    const result = await stmt.executeMany(sets);
+    await stmt.close();
+    assert.strictEqual(typeof result.rowCount, 'number');
+
+    const count = await client.query(`SELECT COUNT(*) AS cnt FROM ${TABLE}`);
+    assert.strictEqual(count.rows[0].cnt, 2500);
+  });
+
+  it('executeMany() with an empty list is a no-op', async () => {
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?)`);
+    const result = await stmt.executeMany([]);
+    await stmt.close();
+    assert.strictEqual(result.rowCount, 0);
+  });
+
+  it('executeMany() rejects non-array parameter sets', async () => {
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?)`);
+    await assert.rejects(() => stmt.executeMany([[1, 'a'], 'oops']), TypeError);
+    await stmt.close();
+  });
+
+  it('withKeySet() joins against loaded integer keys', async () => {
+    const keys = [5, 10, 15, 20, 20, 9999];
+    const result = await client.withKeySet(keys, (keyTable) =>
+      client.query(
+        `SELECT t.id FROM ${TABLE} t JOIN ${keyTable} k ON k.key_value = t.id ORDER BY t.id`
+      )
+    );
+    assert.deepStrictEqual(result.rows.map((r) => r.id), [5, 10, 15, 20]);
+  });
+
+  it('withKeySet() supports string keys and drops the table', async () => {
+    let name;
+    const result = await client.withKeySet(['row1', 'row2'], async (keyTable) => {
+      name = keyTable;
+      return client.query(
+        `SELECT t.id FROM ${TABLE} t JOIN ${keyTable} k ON k.key_value = t.name ORDER BY t.id`
+      );
+    });
+    assert.deepStrictEqual(result.rows.map((r) => r.id), [1, 2]);
+    await assert.rejects(() => client.query(`SELECT * FROM ${name}`));
+  });
+
+  it('withKeySet() drops the table when the callback throws', async () => {
+    let name;
+    await assert.rejects(
+      () => client.withKeySet([1, 2], async (keyTable) => {
+        name = keyTable;
+        throw new Error('boom');
+      }),
+      { message: 'boom' }
+    );
+    await assert.rejects(() => client.query(`SELECT * FROM ${name}`));
+  });
+
+  it('withKeySet() is rejected inside a transaction', async () => {
+    await client.beginTransaction();
+    try {
+      await assert.rejects(
+        () => client.withKeySet([1], async () => {}),
+        { message: /transaction/ }
+      );
+    } finally {
+      await client.rollback();
+    }
+  });
+});
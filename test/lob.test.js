@@ -78,6 +78,43 @@ describe('LOB types (BLOB, NCLOB)', () => {
     assert.strictEqual(result.rows[0].text, text);
   });
 
+  it('lobPreview returns a prefix and the total size', async () => {
+    const data = Buffer.alloc(5000, 7);
+    const stmt = await client.prepare('INSERT INTO test_lob (id, data, text) VALUES (?, ?, ?)');
+    await stmt.execute([900, data, 'åäö'.repeat(100)]);
+    await stmt.close();
+
+    const result = await client.query(
+      'SELECT data, text FROM test_lob WHERE id = ?', [900],
+      { lobPreview: { bytes: 16, chars: 5 } }
+    );
+    assert.deepStrictEqual(result.rows[0].data, {
+      preview: Buffer.alloc(16, 7),
+      totalSize: 5000,
+    });
+    assert.deepStrictEqual(result.rows[0].text, { preview: 'åäöåä', totalSize: 300 });
+
+    // Only BLOBs are previewed when chars is not given
+    const blobOnly = await client.query(
+      'SELECT text FROM test_lob WHERE id = ?', [900], { lobPreview: { bytes: 16 } }
+    );
+    assert.strictEqual(blobOnly.rows[0].text, 'åäö'.repeat(100));
+  });
+
+  it('lobPreview results are not served to plain queries from the cache', async () => {
+    const cached = await createClient({ cache: true });
+    try {
+      const sql = 'SELECT data FROM test_lob WHERE id = ?';
+      const preview = await cached.query(sql, [900], { lobPreview: { bytes: 16 } });
+      assert.strictEqual(preview.rows[0].data.totalSize, 5000);
+      const plain = await cached.query(sql, [900]);
+      assert.ok(Buffer.isBuffer(plain.rows[0].data));
+      assert.strictEqual(plain.rows[0].data.length, 5000);
+    } finally {
+      await cached.close();
+    }
+  });
+
   it('metadata shows BLOB and NCLOB type names', async () => {
     const result = await client.query('SELECT data, text FROM test_lob WHERE id = ?', [1]);
     assert.strictEqual(result.fields[0].dataTypeName, 'BLOB');
@@ -135,3 +172,49 @@ describe('LOB chunked reading', () => {
     assert.strictEqual(result.rows[0].text, text);
   });
 });
+
+describe('Very large NCLOB values', () => {
+  let client;
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, 'test_lob_huge');
+    await client.query(
+      'CREATE TABLE test_lob_huge (id INTEGER, text NCLOB(4000000))'
+    );
+  });
+
+  after(async () => {
+    await dropTable(client, 'test_lob_huge');
+    await client.close();
+  });
+
+  it('ASCII NCLOB over 1MB round-trips', async () => {
+    const text = 'abcdefghij'.repeat(150000);
+    await client.query('INSERT INTO test_lob_huge (id, text) VALUES (?, ?)', [1, text]);
+    const result = await client.query('SELECT text FROM test_lob_huge WHERE id = ?', [1]);
+    assert.strictEqual(result.rows[0].text.length, text.length);
+    assert.strictEqual(result.rows[0].text, text);
+  });
+
+  it('lobPreview reads only the start of each LOB', async () => {
+    await client.query('DELETE FROM test_lob_huge');
+    const text = '\u4e16abc'.repeat(50000);
+    await client.query('INSERT INTO test_lob_huge (id, text) VALUES (?, ?)', [3, text]);
+    const result = await client.query(
+      'SELECT id, text FROM test_lob_huge WHERE id = ?', [3], { lobPreview: { chars: 10 } }
+    );
+    assert.deepStrictEqual(result.rows[0].text, {
+      preview: text.slice(0, 10),
+      totalSize: 200000,
+    });
+    assert.strictEqual(result.rows[0].id, 3);
+  });
+
+  it('multi-byte NCLOB over 1MB round-trips', async () => {
+    const text = 'åäö\u4e16\u{1F600}'.repeat(100000);
+    await client.query('INSERT INTO test_lob_huge (id, text) VALUES (?, ?)', [2, text]);
+    const result = await client.query('SELECT text FROM test_lob_huge WHERE id = ?', [2]);
+    assert.strictEqual(result.rows[0].text, text);
+  });
+});
@@ -42,6 +42,35 @@ describe('prepared statements', () => {
     await stmt.close();
   });
 
+  it('executeMany() on a SELECT returns one row array per set', async () => {
+    const stmt = await client.prepare('SELECT * FROM test_prepared WHERE id = ?');
+    const result = await stmt.executeMany([[10], [99], [12]]);
+    await stmt.close();
+
+    assert.strictEqual(result.rowCount, 2);
+    assert.strictEqual(result.rowSets.length, 3);
+    assert.strictEqual(result.rowSets[0][0].name, 'Prepared1');
+    assert.deepStrictEqual(result.rowSets[1], []);
+    assert.strictEqual(result.rowSets[2][0].name, 'Prepared3');
+    assert.strictEqual(result.fields.length, 2);
+  });
+
+  it('executeMany() on a SELECT can flatten with a set index', async () => {
+    const stmt = await client.prepare('SELECT * FROM test_prepared WHERE id = ?');
+    const result = await stmt.executeMany([[11], [10]], { flatten: true });
+    const custom = await stmt.executeMany([[12]], {
+      flatten: true, setIndexColumn: 'batch',
+    });
+    await stmt.close();
+
+    assert.strictEqual(result.rowCount, 2);
+    assert.deepStrictEqual(
+      result.rows.map((r) => [r._set, r.id]),
+      [[0, 11], [1, 10]]
+    );
+    assert.strictEqual(custom.rows[0].batch, 0);
+  });
+
   it('execute after close throws', async () => {
     const stmt = await client.prepare('SELECT * FROM test_prepared WHERE id = ?');
     await stmt.close();
@@ -0,0 +1,84 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('raw text bytes', () => {
+  let client;
+  const TABLE = 'test_raw_text';
+  const LONG = 'x'.repeat(300) + 'ü';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, code CHAR(3), body NVARCHAR(400), day DATE)`
+    );
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?, ?, ?)`);
+    await stmt.execute([1, 'abc', 'hello åäö 😀', '2026-10-17']);
+    await stmt.execute([2, 'xyz', LONG, '2026-10-18']);
+    await stmt.execute([3, 'nul', null, null]);
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('returns character columns as UTF-8 Buffers', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} ORDER BY id`, [], { rawText: true }
+    );
+    const [first, second, third] = result.rows;
+    assert.ok(Buffer.isBuffer(first.code));
+    assert.deepStrictEqual(first.code, Buffer.from('abc'));
+    assert.deepStrictEqual(first.body, Buffer.from('hello åäö 😀', 'utf8'));
+    assert.deepStrictEqual(second.body, Buffer.from(LONG, 'utf8'));
+    assert.strictEqual(third.body, null);
+    // Non-character columns are unchanged
+    assert.strictEqual(first.id, 1);
+    assert.strictEqual(typeof first.day, 'string');
+  });
+
+  it('applies only to the named columns', async () => {
+    const result = await client.query(
+      `SELECT code, body FROM ${TABLE} WHERE id = 1`, [], { rawText: ['body'] }
+    );
+    assert.strictEqual(result.rows[0].code, 'abc');
+    assert.ok(Buffer.isBuffer(result.rows[0].body));
+  });
+
+  it('composes with binarySlab', async () => {
+    const result = await client.query(
+      `SELECT code, body FROM ${TABLE} ORDER BY id`, [],
+      { rawText: true, binarySlab: true }
+    );
+    const { code, body } = result.rows[0];
+    assert.ok(code instanceof Uint8Array);
+    assert.strictEqual(code.buffer, body.buffer);
+    assert.strictEqual(Buffer.from(body).toString('utf8'), 'hello åäö 😀');
+    assert.strictEqual(result.rows[2].body, null);
+  });
+
+  it('works with prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT body FROM ${TABLE} WHERE id = ?`);
+    const result = await stmt.execute([2], { rawText: true });
+    assert.strictEqual(result.rows[0].body.toString('utf8'), LONG);
+    await stmt.close();
+  });
+
+  it('does not serve raw results to plain queries from the cache', async () => {
+    const cached = await createClient({ cache: true });
+    try {
+      const stmt = await cached.prepare(`SELECT code FROM ${TABLE} WHERE id = ?`);
+      try {
+        assert.ok(Buffer.isBuffer((await stmt.execute([1], { rawText: true })).rows[0].code));
+        assert.strictEqual((await stmt.execute([1])).rows[0].code, 'abc');
+      } finally {
+        await stmt.close();
+      }
+    } finally {
+      await cached.close();
+    }
+  });
+});
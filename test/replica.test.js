@@ -0,0 +1,88 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('replicated reference tables', () => {
+  let client;
+  const TABLE = 'test_replica';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (code CHAR(2), name NVARCHAR(100), row_version INTEGER)`
+    );
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, ['SE', 'Sweden', 1]);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, ['NO', 'Norway', 1]);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('loads a table and serves get() by key', async () => {
+    const table = await client.replicate(TABLE, { key: 'code' });
+    try {
+      assert.strictEqual(table.size, 2);
+      assert.strictEqual(table.get('SE').name, 'Sweden');
+      assert.strictEqual(table.get('XX'), undefined);
+      assert.ok(table.has('NO'));
+      // Same frozen object on every lookup
+      assert.strictEqual(table.get('SE'), table.get('SE'));
+      assert.ok(Object.isFrozen(table.get('SE')));
+    } finally {
+      table.close();
+    }
+  });
+
+  it('accepts a SELECT statement as source', async () => {
+    const table = await client.replicate(
+      `SELECT code, name FROM ${TABLE} WHERE code = 'NO'`, { key: 'code' }
+    );
+    try {
+      assert.strictEqual(table.size, 1);
+      assert.strictEqual(table.get('NO').name, 'Norway');
+    } finally {
+      table.close();
+    }
+  });
+
+  it('incremental refresh picks up new and updated rows', async () => {
+    const table = await client.replicate(TABLE, {
+      key: 'code', versionColumn: 'row_version',
+    });
+    try {
+      await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, ['DK', 'Denmark', 2]);
+      await client.query(
+        `UPDATE ${TABLE} SET name = ?, row_version = ? WHERE code = ?`, ['Sverige', 2, 'SE']
+      );
+      await table.refresh();
+      assert.strictEqual(table.size, 3);
+      assert.strictEqual(table.get('DK').name, 'Denmark');
+      assert.strictEqual(table.get('SE').name, 'Sverige');
+    } finally {
+      table.close();
+    }
+  });
+
+  it('full refresh drops deleted rows', async () => {
+    const table = await client.replicate(TABLE, {
+      key: 'code', versionColumn: 'row_version',
+    });
+    try {
+      await client.query(`DELETE FROM ${TABLE} WHERE code = ?`, ['DK']);
+      await table.refresh({ full: true });
+      assert.strictEqual(table.has('DK'), false);
+    } finally {
+      table.close();
+    }
+  });
+
+  it('requires a key column', async () => {
+    await assert.rejects(
+      () => client.replicate(TABLE, {}),
+      { message: /key/ }
+    );
+  });
+});
@@ -0,0 +1,151 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createPool, ResultCache } = require('../index');
+const { createClient, dropTable } = require('./helper');
+
+const POOL_OPTS = {
+  dsn: 'mimerdb',
+  user: 'SYSADM',
+  password: 'SYSADM',
+};
+
+describe('result cache', () => {
+  let client;
+  const TABLE = 'test_result_cache';
+
+  before(async () => {
+    client = await createClient({ cache: { ttl: 0 } });
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(100))`
+    );
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [1, 'one']);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [2, 'two']);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('repeated query is served from the cache', async () => {
+    const sql = `SELECT name FROM ${TABLE} WHERE id = ?`;
+    const before = client.cacheStats();
+    const r1 = await client.query(sql, [1]);
+    const r2 = await client.query(sql, [1]);
+    const stats = client.cacheStats();
+
+    assert.strictEqual(r1, r2);
+    assert.ok(Object.isFrozen(r1.rows[0]));
+    assert.strictEqual(stats.hits - before.hits, 1);
+    assert.strictEqual(stats.misses - before.misses, 1);
+  });
+
+  it('different parameters are cached separately', async () => {
+    const sql = `SELECT name FROM ${TABLE} WHERE id = ?`;
+    const r1 = await client.query(sql, [1]);
+    const r2 = await client.query(sql, [2]);
+    assert.strictEqual(r1.rows[0].name, 'one');
+    assert.strictEqual(r2.rows[0].name, 'two');
+  });
+
+  it('DML through the client invalidates the table', async () => {
+    const sql = `SELECT COUNT(*) AS cnt FROM ${TABLE}`;
+    const r1 = await client.query(sql);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [3, 'three']);
+    const r2 = await client.query(sql);
+    assert.notStrictEqual(r1, r2);
+    assert.strictEqual(r2.rows[0].cnt, r1.rows[0].cnt + 1);
+  });
+
+  it('prepared statements share the cache and invalidate it', async () => {
+    const sql = `SELECT name FROM ${TABLE} WHERE id = ?`;
+    const stmt = await client.prepare(sql);
+    const r1 = await stmt.execute([1]);
+    const r2 = await client.query(sql, [1]);
+    assert.strictEqual(r1, r2);
+    await stmt.close();
+
+    const upd = await client.prepare(`UPDATE ${TABLE} SET name = ? WHERE id = ?`);
+    await upd.execute(['uno', 1]);
+    await upd.close();
+    const r3 = await client.query(sql, [1]);
+    assert.strictEqual(r3.rows[0].name, 'uno');
+  });
+
+  it('explicit invalidate(tag)', async () => {
+    const sql = `SELECT id FROM ${TABLE} ORDER BY id`;
+    await client.query(sql);
+    assert.ok(client.invalidate(TABLE) >= 1);
+    const before = client.cacheStats().misses;
+    await client.query(sql);
+    assert.strictEqual(client.cacheStats().misses, before + 1);
+  });
+
+  it('tags are unqualified names and views are not expanded', async () => {
+    const VIEW = 'test_result_cache_v';
+    await client.query(`CREATE VIEW ${VIEW} AS SELECT id, name FROM ${TABLE}`);
+    try {
+      const tableSql = `SELECT name FROM ${TABLE} WHERE id = 2`;
+      const viewSql = `SELECT name FROM ${VIEW} WHERE id = 2`;
+      const t1 = await client.query(tableSql);
+      const v1 = await client.query(viewSql);
+
+      // A schema-qualified write invalidates the unqualified read
+      await client.query(`UPDATE SYSADM.${TABLE} SET name = 'dos' WHERE id = 2`);
+      const t2 = await client.query(tableSql);
+      assert.notStrictEqual(t2, t1);
+      assert.strictEqual(t2.rows[0].name, 'dos');
+
+      // The view read still has the old value until invalidated by name
+      const v2 = await client.query(viewSql);
+      assert.strictEqual(v2, v1);
+      assert.strictEqual(v2.rows[0].name, 'two');
+      assert.strictEqual(client.invalidate(VIEW), 1);
+      assert.strictEqual((await client.query(viewSql)).rows[0].name, 'dos');
+    } finally {
+      await client.query(`DROP VIEW ${VIEW}`);
+    }
+  });
+
+  it('reads inside a transaction bypass the cache', async () => {
+    const sql = `SELECT COUNT(*) AS cnt FROM ${TABLE}`;
+    const committed = await client.query(sql);
+    await client.beginTransaction();
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [9, 'tx']);
+    const inside = await client.query(sql);
+    await client.rollback();
+    const afterRollback = await client.query(sql);
+    assert.strictEqual(inside.rows[0].cnt, committed.rows[0].cnt + 1);
+    assert.strictEqual(afterRollback.rows[0].cnt, committed.rows[0].cnt);
+  });
+
+  it('pool cache hit does not need a connection', async () => {
+    const pool = createPool({ ...POOL_OPTS, max: 1, cache: true });
+    try {
+      const sql = `SELECT id FROM ${TABLE} ORDER BY id`;
+      const r1 = await pool.query(sql);
+      const held = await pool.connect();
+      const r2 = await pool.query(sql);  // would time out without the cache
+      held.release();
+      assert.strictEqual(r1, r2);
+      assert.strictEqual(pool.cacheStats().hits, 1);
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('ttl expiry and LRU eviction', async () => {
+    const cache = new ResultCache({ ttl: 20, maxEntries: 1 });
+    const result = { rows: [{ a: 1 }], rowCount: 1 };
+    cache.set('SELECT a FROM t1', [], result);
+    assert.ok(cache.get('SELECT a FROM t1', []));
+    await new Promise((resolve) => setTimeout(resolve, 40));
+    assert.strictEqual(cache.get('SELECT a FROM t1', []), undefined);
+
+    cache.set('SELECT a FROM t1', [], { rows: [] });
+    cache.set('SELECT a FROM t2', [], { rows: [] });
+    assert.strictEqual(cache.stats().entries, 1);
+    assert.strictEqual(cache.stats().evictions, 1);
+  });
+});
@@ -0,0 +1,105 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('result limits', () => {
+  let client;
+  const TABLE = 'test_limits';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, payload NVARCHAR(100))`);
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?)`);
+    const sets = [];
+    for (let i = 1; i <= 20; i++) {
+      sets.push([i, 'x'.repeat(50)]);
+    }
+    await stmt.executeMany(sets);
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('throws when maxRows is exceeded', async () => {
+    await assert.rejects(
+      () => client.query(`SELECT * FROM ${TABLE}`, [], { maxRows: 5 }),
+      (err) => err.limit === 'maxRows'
+    );
+  });
+
+  it('truncates at maxRows', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} ORDER BY id`, [], { maxRows: 5, onLimit: 'truncate' }
+    );
+    assert.strictEqual(result.rows.length, 5);
+    assert.strictEqual(result.rows[4].id, 5);
+    assert.strictEqual(result.truncated, true);
+  });
+
+  it('does not flag a result that fits exactly', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE}`, [], { maxRows: 20, onLimit: 'truncate' }
+    );
+    assert.strictEqual(result.rows.length, 20);
+    assert.strictEqual(result.truncated, undefined);
+  });
+
+  it('enforces maxBytes', async () => {
+    const result = await client.query(
+      `SELECT payload FROM ${TABLE}`, [], { maxBytes: 200, onLimit: 'truncate' }
+    );
+    assert.strictEqual(result.rows.length, 4);
+    assert.strictEqual(result.truncated, true);
+
+    await assert.rejects(
+      () => client.query(`SELECT payload FROM ${TABLE}`, [], { maxBytes: 200 }),
+      (err) => err.limit === 'maxBytes'
+    );
+  });
+
+  it('applies to prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} WHERE id > ?`);
+    const result = await stmt.execute([10], { maxRows: 3, onLimit: 'truncate' });
+    assert.strictEqual(result.rows.length, 3);
+    assert.strictEqual(result.truncated, true);
+
+    // Statement is reusable after an early close
+    const full = await stmt.execute([18]);
+    assert.strictEqual(full.rowCount, 2);
+    await stmt.close();
+  });
+
+  it('uses the connection default', async () => {
+    const limited = await createClient({ maxRows: 10 });
+    try {
+      await assert.rejects(() => limited.query(`SELECT * FROM ${TABLE}`), /maxRows/);
+      const override = await limited.query(`SELECT * FROM ${TABLE}`, [], { maxRows: 0 });
+      assert.strictEqual(override.rowCount, 20);
+    } finally {
+      await limited.close();
+    }
+  });
+
+  it('rejects invalid options', async () => {
+    await assert.rejects(
+      () => client.query(`SELECT * FROM ${TABLE}`, [], { onLimit: 'drop' }),
+      TypeError
+    );
+    for (const maxRows of [-1, 1.5, 2 ** 53, '10', NaN]) {
+      await assert.rejects(
+        () => client.query(`SELECT * FROM ${TABLE}`, [], { maxRows }),
+        { name: 'TypeError', message: /maxRows must be a non-negative safe integer/ }
+      );
+    }
+  });
+
+  it('accepts maxRows above 2^32', async () => {
+    const r = await client.query(`SELECT * FROM ${TABLE}`, [], { maxRows: 2 ** 32 + 1 });
+    assert.ok(!r.truncated);
+    assert.ok(r.rowCount > 0);
+  });
+});
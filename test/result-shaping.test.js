@@ -0,0 +1,135 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('result shaping', () => {
+  let client;
+  const ORDERS = 'test_shape_orders';
+  const LINES = 'test_shape_lines';
+  const JOIN = `SELECT o.id, o.customer, l.product, l.qty
+                  FROM ${ORDERS} o JOIN ${LINES} l ON l.order_id = o.id
+                 ORDER BY o.id, l.product`;
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, LINES);
+    await dropTable(client, ORDERS);
+    await client.query(`CREATE TABLE ${ORDERS} (id INTEGER, customer NVARCHAR(50))`);
+    await client.query(
+      `CREATE TABLE ${LINES} (order_id INTEGER, product NVARCHAR(50), qty INTEGER)`
+    );
+    await client.query(`INSERT INTO ${ORDERS} VALUES (1, 'Ada')`);
+    await client.query(`INSERT INTO ${ORDERS} VALUES (2, 'Alan')`);
+    await client.query(`INSERT INTO ${LINES} VALUES (1, 'coffee', 1)`);
+    await client.query(`INSERT INTO ${LINES} VALUES (1, 'tea', 2)`);
+    await client.query(`INSERT INTO ${LINES} VALUES (2, 'milk', 3)`);
+  });
+
+  after(async () => {
+    await dropTable(client, LINES);
+    await dropTable(client, ORDERS);
+    await client.close();
+  });
+
+  it('returns a Map with keyBy', async () => {
+    const result = await client.query(
+      `SELECT id, customer FROM ${ORDERS}`, [], { keyBy: 'id' }
+    );
+    assert.ok(result.rows instanceof Map);
+    assert.strictEqual(result.rows.size, 2);
+    assert.deepStrictEqual(result.rows.get(2), { id: 2, customer: 'Alan' });
+    assert.strictEqual(result.rowCount, 2);
+  });
+
+  it('keeps the last row for a repeated key', async () => {
+    const { rows } = await client.query(JOIN, [], { keyBy: 'id' });
+    assert.strictEqual(rows.size, 2);
+    assert.strictEqual(rows.get(1).product, 'tea');
+  });
+
+  it('nests child columns under their parent', async () => {
+    const result = await client.query(JOIN, [], {
+      nest: { parentKey: 'id', childColumns: ['product', 'qty'], as: 'lines' },
+    });
+    assert.deepStrictEqual(result.rows, [
+      { id: 1, customer: 'Ada', lines: [
+        { product: 'coffee', qty: 1 },
+        { product: 'tea', qty: 2 },
+      ] },
+      { id: 2, customer: 'Alan', lines: [{ product: 'milk', qty: 3 }] },
+    ]);
+    assert.strictEqual(result.rowCount, 3);
+  });
+
+  it('names the child array children by default', async () => {
+    const { rows } = await client.query(JOIN, [], {
+      nest: { parentKey: 'id', childColumns: ['product', 'qty'] },
+    });
+    assert.strictEqual(rows[1].children.length, 1);
+  });
+
+  it('applies to prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT id, customer FROM ${ORDERS} WHERE id > ?`);
+    try {
+      const { rows } = await stmt.execute([0], { keyBy: 'customer' });
+      assert.strictEqual(rows.get('Ada').id, 1);
+    } finally {
+      await stmt.close();
+    }
+  });
+
+  it('rejects keyBy on a binarySlab column', async () => {
+    const BIN = 'test_shape_bin';
+    await dropTable(client, BIN);
+    await client.query(`CREATE TABLE ${BIN} (code VARBINARY(8), name NVARCHAR(20))`);
+    try {
+      await client.query(`INSERT INTO ${BIN} VALUES (?, ?)`, [Buffer.from([1]), 'one']);
+      await client.query(`INSERT INTO ${BIN} VALUES (?, ?)`, [Buffer.from([2]), 'two']);
+      await assert.rejects(
+        client.query(`SELECT code, name FROM ${BIN}`, [], { keyBy: 'code', binarySlab: true }),
+        /keyBy column 'code' cannot be decoded with binarySlab/
+      );
+      // Other columns may still use the slab
+      const { rows } = await client.query(
+        `SELECT code, name FROM ${BIN}`, [], { keyBy: 'name', binarySlab: true }
+      );
+      assert.strictEqual(rows.size, 2);
+      assert.deepStrictEqual(Buffer.from(rows.get('two').code), Buffer.from([2]));
+    } finally {
+      await dropTable(client, BIN);
+    }
+  });
+
+  it('rejects unknown columns and combined options', async () => {
+    await assert.rejects(
+      client.query(`SELECT id FROM ${ORDERS}`, [], { keyBy: 'missing' }),
+      /keyBy column 'missing'/
+    );
+    await assert.rejects(
+      client.query(`SELECT id FROM ${ORDERS}`, [], {
+        keyBy: 'id', nest: { parentKey: 'id', childColumns: [] },
+      }),
+      /cannot be combined/
+    );
+  });
+
+  it('does not serve shaped results to plain queries from the cache', async () => {
+    const cached = await createClient({ cache: true });
+    try {
+      const sql = `SELECT id, customer FROM ${ORDERS} ORDER BY id`;
+      assert.ok((await cached.query(sql, [], { keyBy: 'id' })).rows instanceof Map);
+      const nested = await cached.query(sql, [], {
+        nest: { parentKey: 'id', childColumns: ['customer'] },
+      });
+      assert.ok(Array.isArray(nested.rows[0].children));
+      const plain = await cached.query(sql);
+      assert.deepStrictEqual(plain.rows, [
+        { id: 1, customer: 'Ada' },
+        { id: 2, customer: 'Alan' },
+      ]);
+      assert.strictEqual(cached.cacheStats().hits, 0);
+    } finally {
+      await cached.close();
+    }
+  });
+});
@@ -0,0 +1,113 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('row factory', () => {
+  let client;
+  const TABLE = 'test_row_factory';
+
+  class User {
+    get displayName() {
+      return `${this.firstName} ${this.lastName}`;
+    }
+  }
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, first_name NVARCHAR(50), last_name NVARCHAR(50))`
+    );
+    await client.query(`INSERT INTO ${TABLE} VALUES (1, 'Ada', 'Lovelace')`);
+    await client.query(`INSERT INTO ${TABLE} VALUES (2, 'Alan', 'Turing')`);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('creates rows as class instances', async () => {
+    const { rows } = await client.query(
+      `SELECT id, first_name, last_name FROM ${TABLE} ORDER BY id`, [],
+      { rowFactory: User, fieldMap: { first_name: 'firstName', last_name: 'lastName' } }
+    );
+    assert.strictEqual(rows.length, 2);
+    assert.ok(rows[0] instanceof User);
+    assert.strictEqual(rows[0].displayName, 'Ada Lovelace');
+    assert.deepStrictEqual(Object.keys(rows[1]), ['id', 'firstName', 'lastName']);
+  });
+
+  it('runs the constructor before assigning columns', async () => {
+    class Counted {
+      constructor() {
+        this.loaded = true;
+      }
+    }
+    const { rows } = await client.query(
+      `SELECT id FROM ${TABLE} ORDER BY id`, [], { rowFactory: Counted }
+    );
+    assert.deepStrictEqual(Object.keys(rows[0]), ['loaded', 'id']);
+    assert.strictEqual(rows[1].id, 2);
+  });
+
+  it('renames columns without a factory', async () => {
+    const { rows } = await client.query(
+      `SELECT id, first_name FROM ${TABLE} WHERE id = 1`, [],
+      { fieldMap: { first_name: 'name' } }
+    );
+    assert.deepStrictEqual(rows[0], { id: 1, name: 'Ada' });
+  });
+
+  it('works with prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT first_name, last_name FROM ${TABLE} WHERE id = ?`);
+    const { rows } = await stmt.execute([2], {
+      rowFactory: User, fieldMap: { first_name: 'firstName', last_name: 'lastName' },
+    });
+    assert.strictEqual(rows[0].displayName, 'Alan Turing');
+    await stmt.close();
+  });
+
+  it('releases the cursor when the constructor throws', async () => {
+    class Broken {
+      constructor() {
+        throw new Error('constructor failed');
+      }
+    }
+    const sql = `SELECT id FROM ${TABLE} ORDER BY id`;
+    await assert.rejects(client.query(sql, [], { rowFactory: Broken }), /constructor failed/);
+    assert.strictEqual((await client.query(sql)).rowCount, 2);
+
+    // The prepared cursor is closed, so the statement can run again
+    const stmt = await client.prepare(sql);
+    try {
+      await assert.rejects(stmt.execute([], { rowFactory: Broken }), /constructor failed/);
+      assert.strictEqual((await stmt.execute()).rowCount, 2);
+    } finally {
+      await stmt.close();
+    }
+  });
+
+  it('rejects a non-function rowFactory', async () => {
+    await assert.rejects(
+      () => client.query(`SELECT id FROM ${TABLE}`, [], { rowFactory: {} }),
+      TypeError
+    );
+  });
+
+  it('does not serve hydrated rows to plain queries from the cache', async () => {
+    const cached = await createClient({ cache: true });
+    try {
+      const sql = `SELECT first_name FROM ${TABLE} WHERE id = ?`;
+      const hydrated = await cached.query(sql, [1], {
+        rowFactory: User, fieldMap: { first_name: 'firstName' },
+      });
+      assert.ok(hydrated.rows[0] instanceof User);
+      const plain = await cached.query(sql, [1]);
+      assert.ok(!(plain.rows[0] instanceof User));
+      assert.deepStrictEqual({ ...plain.rows[0] }, { first_name: 'Ada' });
+    } finally {
+      await cached.close();
+    }
+  });
+});
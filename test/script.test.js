@@ -0,0 +1,201 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('executeScript', () => {
+  let client;
+  const TABLE = 'test_script';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('splits and runs DDL and DML, honoring quotes and comments', async () => {
+    const result = await client.executeScript(`
+      CREATE TABLE ${TABLE} (id INTEGER PRIMARY KEY, name NVARCHAR(50));
+      -- a comment; with a semicolon
+      INSERT INTO ${TABLE} VALUES (1, 'one;1');
+      /* block; comment */
+      INSERT INTO ${TABLE} VALUES (2, 'it''s two');
+      SELECT * FROM ${TABLE};
+    `);
+
+    assert.strictEqual(result.statementCount, 4);
+    assert.strictEqual(result.executed, 4);
+    assert.strictEqual(result.rowCount, 2);
+    assert.deepStrictEqual(result.errors, []);
+
+    const rows = (await client.query(`SELECT name FROM ${TABLE} ORDER BY id`)).rows;
+    assert.deepStrictEqual(rows.map((r) => r.name), ['one;1', "it's two"]);
+  });
+
+  it('keeps splitting after a compound CASE in a routine body', async () => {
+    const PROC = 'test_script_case';
+    try {
+      const result = await client.executeScript(`
+        CREATE PROCEDURE ${PROC}(IN x INTEGER, OUT y NVARCHAR(10))
+        BEGIN
+          CASE x
+            WHEN 1 THEN SET y = 'one';
+            ELSE SET y = 'other';
+          END CASE;
+        END;
+        INSERT INTO ${TABLE} VALUES (10, 'ten');
+        DELETE FROM ${TABLE} WHERE id = 10;
+      `);
+      assert.strictEqual(result.statementCount, 3);
+      assert.strictEqual(result.executed, 3);
+    } finally {
+      await dropProcedure(PROC);
+    }
+  });
+
+  async function dropProcedure(name) {
+    try {
+      await client.query(`DROP PROCEDURE ${name}`);
+    } catch (e) {
+      // Ignore — procedure may not exist
+    }
+  }
+
+  it('keeps splitting after a nested BEGIN ... END; block', async () => {
+    const PROC = 'test_script_nested';
+    try {
+      const result = await client.executeScript(`
+        CREATE PROCEDURE ${PROC}(OUT y INTEGER)
+        BEGIN
+          DECLARE x INTEGER DEFAULT 0;
+          BEGIN
+            SET x = 1;
+          END;
+          IF x = 1 THEN
+            SET y = 2;
+          END IF;
+        END;
+        INSERT INTO ${TABLE} VALUES (11, 'eleven');
+        DELETE FROM ${TABLE} WHERE id = 11;
+      `);
+      assert.strictEqual(result.statementCount, 3);
+      assert.strictEqual(result.executed, 3);
+    } finally {
+      await dropProcedure(PROC);
+    }
+  });
+
+  it('keeps splitting when control statements follow CASE ... END;', async () => {
+    const PROC = 'test_script_loops';
+    try {
+      const result = await client.executeScript(`
+        CREATE PROCEDURE ${PROC}(IN a INTEGER, OUT y INTEGER)
+        READS SQL DATA
+        BEGIN
+          DECLARE x INTEGER DEFAULT 0;
+          SET x = CASE WHEN a > 0 THEN 1 ELSE 0 END;
+          IF x = 1 THEN SET x = 2; END IF;
+          SET x = CASE WHEN x > 0 THEN x ELSE 0 END;
+          WHILE x < 3 DO SET x = x + 1; END WHILE;
+          SET x = CASE WHEN x > 0 THEN x ELSE 0 END;
+          REPEAT SET x = x + 1; UNTIL x > 4 END REPEAT;
+          SET x = CASE WHEN x > 0 THEN x ELSE 0 END;
+          FOR SELECT 1 AS n FROM system.onerow DO SET x = x + n; END FOR;
+          l1: LOOP
+            SET x = x + 1;
+            IF x > 7 THEN LEAVE l1; END IF;
+          END LOOP;
+          SET y = x;
+        END;
+        INSERT INTO ${TABLE} VALUES (12, 'twelve');
+        DELETE FROM ${TABLE} WHERE id = 12;
+      `);
+      assert.strictEqual(result.statementCount, 3);
+      assert.strictEqual(result.executed, 3);
+    } finally {
+      await dropProcedure(PROC);
+    }
+  });
+
+  it('accepts an array of statements', async () => {
+    const result = await client.executeScript([
+      `INSERT INTO ${TABLE} VALUES (3, 'three')`,
+      `DELETE FROM ${TABLE} WHERE id = 3`,
+    ]);
+    assert.strictEqual(result.executed, 2);
+    assert.strictEqual(result.rowCount, 2);
+  });
+
+  it('throws the first failure with its statement index', async () => {
+    await assert.rejects(
+      () => client.executeScript(`
+        INSERT INTO ${TABLE} VALUES (10, 'ten');
+        INSERT INTO ${TABLE} VALUES (10, 'duplicate');
+        INSERT INTO ${TABLE} VALUES (11, 'never');
+      `),
+      (err) => {
+        assert.strictEqual(err.statementIndex, 1);
+        assert.match(err.sql, /duplicate/);
+        assert.strictEqual(typeof err.mimerCode, 'number');
+        return true;
+      }
+    );
+    const r = await client.query(`SELECT id FROM ${TABLE} WHERE id >= 10 ORDER BY id`);
+    assert.deepStrictEqual(r.rows.map((row) => row.id), [10]);
+  });
+
+  it('collects errors with stopOnError: false', async () => {
+    const result = await client.executeScript([
+      `INSERT INTO ${TABLE} VALUES (10, 'again')`,
+      `INSERT INTO ${TABLE} VALUES (12, 'twelve')`,
+    ], { stopOnError: false });
+
+    assert.strictEqual(result.statementCount, 2);
+    assert.strictEqual(result.executed, 1);
+    assert.strictEqual(result.errors.length, 1);
+    assert.strictEqual(result.errors[0].statementIndex, 0);
+    assert.ok(result.errors[0] instanceof Error);
+  });
+
+  it('rolls back the whole script in a transaction', async () => {
+    await assert.rejects(() => client.executeScript([
+      `INSERT INTO ${TABLE} VALUES (20, 'twenty')`,
+      `INSERT INTO ${TABLE} VALUES (20, 'duplicate')`,
+    ], { transaction: true }));
+
+    const r = await client.query(`SELECT id FROM ${TABLE} WHERE id = 20`);
+    assert.strictEqual(r.rowCount, 0);
+  });
+
+  it('rejects DDL in a transaction script before running anything', async () => {
+    await assert.rejects(
+      () => client.executeScript(`
+        INSERT INTO ${TABLE} VALUES (30, 'thirty');
+        /* not covered by rollback */ CREATE TABLE test_script_ddl (id INTEGER);
+      `, { transaction: true }),
+      (err) => {
+        assert.ok(err instanceof TypeError);
+        assert.match(err.message, /cannot run DDL/);
+        assert.strictEqual(err.statementIndex, 1);
+        return true;
+      }
+    );
+    const r = await client.query(`SELECT id FROM ${TABLE} WHERE id = 30`);
+    assert.strictEqual(r.rowCount, 0);
+  });
+
+  it('rejects transaction: true inside an explicit transaction', async () => {
+    await client.beginTransaction();
+    try {
+      await assert.rejects(
+        () => client.executeScript([`DELETE FROM ${TABLE}`], { transaction: true }),
+        /inside a transaction/
+      );
+    } finally {
+      await client.rollback();
+    }
+  });
+});
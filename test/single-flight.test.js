@@ -0,0 +1,133 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createPool, hashParams } = require('../index');
+const { createClient, dropTable } = require('./helper');
+
+const POOL_OPTS = {
+  dsn: 'mimerdb',
+  user: 'SYSADM',
+  password: 'SYSADM',
+};
+
+describe('single-flight reads', () => {
+  let setupClient;
+  const TABLE = 'test_single_flight';
+
+  before(async () => {
+    setupClient = await createClient();
+    await dropTable(setupClient, TABLE);
+    await setupClient.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(100))`
+    );
+    const stmt = await setupClient.prepare(`INSERT INTO ${TABLE} VALUES (?, ?)`);
+    for (let i = 1; i <= 3; i++) {
+      await stmt.execute([i, `row${i}`]);
+    }
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(setupClient, TABLE);
+    await setupClient.close();
+  });
+
+  it('hashParams is deterministic and type-sensitive', () => {
+    assert.strictEqual(hashParams([1, 'a']), hashParams([1, 'a']));
+    assert.strictEqual(hashParams([1, 'a']).length, 16);
+    assert.notStrictEqual(hashParams([1]), hashParams(['1']));
+    assert.notStrictEqual(hashParams(['ab', 'c']), hashParams(['a', 'bc']));
+    assert.strictEqual(hashParams([null]), hashParams([undefined]));
+    assert.strictEqual(
+      hashParams([Buffer.from([1, 2])]),
+      hashParams([Buffer.from([1, 2])])
+    );
+  });
+
+  it('concurrent identical queries share one result', async () => {
+    const pool = createPool({ ...POOL_OPTS, max: 4, singleFlight: true });
+    try {
+      const sql = `SELECT id, name FROM ${TABLE} WHERE id > ? ORDER BY id`;
+      const [a, b, c] = await Promise.all([
+        pool.query(sql, [1]),
+        pool.query(sql, [1]),
+        pool.query(`SELECT id, name   FROM ${TABLE}  WHERE id > ? ORDER BY id`, [1]),
+      ]);
+      assert.strictEqual(a, b);
+      assert.strictEqual(a, c);
+      assert.strictEqual(a.rows.length, 2);
+      // Only one connection was needed
+      assert.strictEqual(pool.totalCount, 1);
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('different parameters execute separately', async () => {
+    const pool = createPool({ ...POOL_OPTS, max: 4, singleFlight: true });
+    try {
+      const sql = `SELECT name FROM ${TABLE} WHERE id = ?`;
+      const [a, b] = await Promise.all([
+        pool.query(sql, [1]),
+        pool.query(sql, [2]),
+      ]);
+      assert.notStrictEqual(a, b);
+      assert.strictEqual(a.rows[0].name, 'row1');
+      assert.strictEqual(b.rows[0].name, 'row2');
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('sequential queries are not shared', async () => {
+    const pool = createPool({ ...POOL_OPTS, singleFlight: true });
+    try {
+      const sql = `SELECT id FROM ${TABLE} ORDER BY id`;
+      const a = await pool.query(sql);
+      const b = await pool.query(sql);
+      assert.notStrictEqual(a, b);
+      assert.deepStrictEqual(a.rows, b.rows);
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('freezes shared rows by default', async () => {
+    const pool = createPool({ ...POOL_OPTS, singleFlight: true });
+    try {
+      const result = await pool.query(`SELECT id FROM ${TABLE} ORDER BY id`);
+      assert.ok(Object.isFrozen(result));
+      assert.ok(Object.isFrozen(result.rows));
+      assert.ok(Object.isFrozen(result.rows[0]));
+      assert.throws(() => { result.rows[0].id = 99; }, TypeError);
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('freeze: false leaves results mutable', async () => {
+    const pool = createPool({ ...POOL_OPTS, singleFlight: { freeze: false } });
+    try {
+      const result = await pool.query(`SELECT id FROM ${TABLE} ORDER BY id`);
+      assert.ok(!Object.isFrozen(result.rows[0]));
+    } finally {
+      await pool.end();
+    }
+  });
+
+  it('DML is never deduplicated', async () => {
+    const pool = createPool({ ...POOL_OPTS, max: 2, singleFlight: true });
+    try {
+      const sql = `INSERT INTO ${TABLE} VALUES (?, ?)`;
+      await Promise.all([
+        pool.query(sql, [100, 'dup']),
+        pool.query(sql, [100, 'dup']),
+      ]);
+      const result = await pool.query(
+        `SELECT COUNT(*) AS cnt FROM ${TABLE} WHERE id = 100`
+      );
+      assert.strictEqual(result.rows[0].cnt, 2);
+    } finally {
+      await pool.end();
+    }
+  });
+});
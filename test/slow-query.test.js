@@ -0,0 +1,108 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+const { SlowQueryLog } = require('../index');
+
+describe('slow query log', () => {
+  let client;
+  let quiet;
+  const entries = [];
+  const TABLE = 'test_slow_query';
+
+  before(async () => {
+    // A threshold of 0 reports every statement
+    client = await createClient({
+      slowQuery: { thresholdMs: 0, sink: (entry) => entries.push(entry) },
+    });
+    quiet = await createClient({
+      slowQuery: { thresholdMs: 60000, sink: (entry) => entries.push(entry) },
+    });
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(20))`);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [1, 'one']);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [2, 'two']);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+    await quiet.close();
+  });
+
+  it('reports SQL, parameter types, timing, rows and stack', async function lookup() {
+    entries.length = 0;
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} WHERE id > ? AND name <> ?`, [0, 'x']
+    );
+    assert.strictEqual(result.timing, undefined);
+    assert.strictEqual(entries.length, 1);
+    const entry = entries[0];
+    assert.strictEqual(entry.operation, 'query');
+    assert.strictEqual(entry.fingerprint, `SELECT * FROM ${TABLE} WHERE id > ? AND name <> ?`);
+    assert.strictEqual(entry.rowCount, 2);
+    assert.deepStrictEqual(entry.paramTypes, ['number', 'string']);
+    assert.strictEqual(entry.params, undefined);
+    assert.ok(entry.durationMs >= 0);
+    assert.ok(entry.timing && entry.timing.execute >= 0);
+    assert.match(entry.stack, /lookup .*slow-query\.test\.js/);
+    assert.doesNotMatch(entry.stack, /lib[\\/](client|slowlog)\.js/);
+  });
+
+  it('includes values when redact is false', async () => {
+    const seen = [];
+    const other = await createClient({
+      slowQuery: { thresholdMs: 0, redact: false, sink: (entry) => seen.push(entry) },
+    });
+    try {
+      await other.query(`SELECT name FROM ${TABLE} WHERE id = ?`, [2]);
+    } finally {
+      await other.close();
+    }
+    assert.deepStrictEqual(seen[0].params, [2]);
+  });
+
+  it('reports prepared executions and failures', async () => {
+    entries.length = 0;
+    const stmt = await client.prepare(`SELECT name FROM ${TABLE} WHERE id = ?`);
+    try {
+      await stmt.execute([1]);
+    } finally {
+      await stmt.close();
+    }
+    await assert.rejects(client.query(`SELECT nosuchcolumn FROM ${TABLE}`));
+    assert.strictEqual(entries[0].operation, 'execute');
+    assert.strictEqual(entries[0].rowCount, 1);
+    assert.ok(entries[1].error);
+    assert.strictEqual(entries[1].rowCount, null);
+  });
+
+  it('keeps timing on results that asked for it', async () => {
+    entries.length = 0;
+    const result = await client.query(`SELECT * FROM ${TABLE}`, [], { timing: true });
+    assert.ok(result.timing.execute >= 0);
+    assert.strictEqual(entries[0].timing, result.timing);
+  });
+
+  it('stays quiet under the threshold', async () => {
+    entries.length = 0;
+    await quiet.query(`SELECT * FROM ${TABLE}`);
+    assert.strictEqual(entries.length, 0);
+  });
+
+  it('ignores errors thrown by the sink', async () => {
+    const other = await createClient({
+      slowQuery: { thresholdMs: 0, sink: () => { throw new Error('sink failed'); } },
+    });
+    try {
+      const { rowCount } = await other.query(`SELECT * FROM ${TABLE}`);
+      assert.strictEqual(rowCount, 2);
+    } finally {
+      await other.close();
+    }
+  });
+
+  it('validates options', () => {
+    assert.throws(() => new SlowQueryLog({}), /thresholdMs/);
+    assert.throws(() => new SlowQueryLog({ thresholdMs: 1, sink: 'log' }), /sink/);
+  });
+});
@@ -0,0 +1,87 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+const { SpilledRows } = require('../index');
+
+describe('spilled results', () => {
+  let client;
+  const TABLE = 'test_spill';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(100), score DOUBLE PRECISION)`);
+    const stmt = await client.prepare(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`);
+    const sets = [];
+    for (let i = 1; i <= 50; i++) {
+      sets.push([i, i % 10 === 0 ? null : `name ${i} åäö`, i / 4]);
+    }
+    await stmt.executeMany(sets);
+    await stmt.close();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('keeps small results in memory', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} ORDER BY id`, [], { spill: true }
+    );
+    assert.ok(result.rows instanceof SpilledRows);
+    assert.strictEqual(result.spilled, true);
+    assert.strictEqual(result.rows.spilled, false);
+    assert.strictEqual(result.rows.length, 50);
+    assert.strictEqual(result.rowCount, 50);
+    assert.deepStrictEqual(result.rows.get(0), { id: 1, name: 'name 1 åäö', score: 0.25 });
+    result.rows.close();
+  });
+
+  it('spills rows past memoryBytes to a temporary file', async () => {
+    const result = await client.query(
+      `SELECT * FROM ${TABLE} ORDER BY id`, [], { spill: { memoryBytes: 0 } }
+    );
+    assert.strictEqual(result.rows.spilled, true);
+    assert.strictEqual(result.rows.length, 50);
+
+    // Random access in both directions
+    assert.strictEqual(result.rows.get(49).id, 50);
+    assert.strictEqual(result.rows.get(9).name, null);
+    assert.strictEqual(result.rows.get(2).name, 'name 3 åäö');
+
+    const ids = [];
+    for (const row of result.rows) {
+      ids.push(row.id);
+    }
+    assert.strictEqual(ids.length, 50);
+    assert.strictEqual(ids[49], 50);
+    result.rows.close();
+  });
+
+  it('rejects out-of-range indexes and use after close', async () => {
+    const result = await client.query(`SELECT id FROM ${TABLE}`, [], { spill: true });
+    assert.throws(() => result.rows.get(50), RangeError);
+    assert.throws(() => result.rows.get(-1), RangeError);
+    result.rows.close();
+    assert.throws(() => result.rows.get(0), /closed/);
+  });
+
+  it('honours maxRows', async () => {
+    const result = await client.query(`SELECT id FROM ${TABLE}`, [], {
+      spill: { memoryBytes: 0 }, maxRows: 10, onLimit: 'truncate',
+    });
+    assert.strictEqual(result.rows.length, 10);
+    assert.strictEqual(result.truncated, true);
+    result.rows.close();
+  });
+
+  it('works with prepared statements', async () => {
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} WHERE id > ? ORDER BY id`);
+    const result = await stmt.execute([45], { spill: { memoryBytes: 0 } });
+    assert.strictEqual(result.rows.length, 5);
+    assert.strictEqual(result.rows.get(0).id, 46);
+    result.rows.close();
+    await stmt.close();
+  });
+});
@@ -0,0 +1,99 @@
+const { describe, it, before, after, beforeEach } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+const {
+  getStatementStats, resetStatementStats, statementLatencyBuckets, fingerprint,
+} = require('../index');
+
+function entryFor(sql) {
+  return getStatementStats({ limit: 0 }).find((e) => e.fingerprint === fingerprint(sql));
+}
+
+describe('statement statistics', () => {
+  let client;
+  const TABLE = 'test_stmt_stats';
+
+  before(async () => {
+    client = await createClient({ statementStats: true });
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(20))`);
+    for (let i = 1; i <= 5; i++) {
+      await client.query(`INSERT INTO ${TABLE} VALUES (${i}, 'row ${i}')`);
+    }
+  });
+
+  beforeEach(() => {
+    resetStatementStats();
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('aggregates queries that differ only in literals', async () => {
+    await client.query(`SELECT * FROM ${TABLE} WHERE id = 1`);
+    await client.query(`SELECT * FROM ${TABLE} WHERE id = 2`);
+    await client.query(`SELECT * FROM ${TABLE} WHERE id > 2`);
+
+    const entry = entryFor(`SELECT * FROM ${TABLE} WHERE id = 1`);
+    assert.strictEqual(entry.calls, 2);
+    assert.strictEqual(entry.rows, 2);
+    assert.strictEqual(entry.errors, 0);
+    assert.ok(entry.maxTime <= entry.totalTime);
+    assert.strictEqual(entry.meanTime, entry.totalTime / 2);
+    assert.strictEqual(entry.histogram.length, statementLatencyBuckets.length + 1);
+    assert.strictEqual(entry.histogram.reduce((a, b) => a + b, 0), 2);
+    assert.strictEqual(entryFor(`SELECT * FROM ${TABLE} WHERE id > 2`).rows, 3);
+  });
+
+  it('records prepared executions under the prepared SQL', async () => {
+    const sql = `SELECT name FROM ${TABLE} WHERE id = ?`;
+    const stmt = await client.prepare(sql);
+    try {
+      await stmt.execute([1]);
+      await stmt.execute([2]);
+    } finally {
+      await stmt.close();
+    }
+    assert.strictEqual(entryFor(sql).calls, 2);
+  });
+
+  it('counts rows fetched through a cursor', async () => {
+    const sql = `SELECT id FROM ${TABLE} ORDER BY id`;
+    const rs = await client.queryCursor(sql);
+    let count = 0;
+    for await (const row of rs) {
+      count += row.id > 0 ? 1 : 0;
+    }
+    const entry = entryFor(sql);
+    assert.strictEqual(entry.calls, 1);
+    assert.strictEqual(entry.rows, count);
+  });
+
+  it('counts failures', async () => {
+    await assert.rejects(client.query(`SELECT nosuchcolumn FROM ${TABLE}`));
+    assert.strictEqual(entryFor(`SELECT nosuchcolumn FROM ${TABLE}`).errors, 1);
+  });
+
+  it('orders and limits the export', async () => {
+    for (let i = 0; i < 3; i++) {
+      await client.query(`SELECT COUNT(*) FROM ${TABLE}`);
+    }
+    await client.query(`SELECT MAX(id) FROM ${TABLE}`);
+    const top = getStatementStats({ limit: 1, orderBy: 'calls' });
+    assert.strictEqual(top.length, 1);
+    assert.strictEqual(top[0].fingerprint, fingerprint(`SELECT COUNT(*) FROM ${TABLE}`));
+    assert.throws(() => getStatementStats({ orderBy: 'name' }), /orderBy/);
+  });
+
+  it('does not record clients without statementStats', async () => {
+    const other = await createClient();
+    try {
+      await other.query(`SELECT id FROM ${TABLE} WHERE id = 3`);
+    } finally {
+      await other.close();
+    }
+    assert.strictEqual(getStatementStats({ limit: 0 }).length, 0);
+  });
+});
@@ -0,0 +1,116 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+const { getStats } = require('../index');
+
+function delta(before, after) {
+  const result = {};
+  for (const [key, value] of Object.entries(after)) {
+    result[key] = typeof value === 'object' ? delta(before[key], value) : value - before[key];
+  }
+  return result;
+}
+
+describe('operation counters', () => {
+  let client;
+  const TABLE = 'test_stats';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(20), data VARBINARY(20), note NCLOB)`
+    );
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?, ?)`,
+      [1, 'abc', Buffer.from([1, 2, 3, 4]), 'hello']);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?, ?)`, [2, null, null, null]);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('counts statements, rows, cells and bytes of a query', async () => {
+    const start = client.getStats();
+    await client.query(`SELECT id, name, data, note FROM ${TABLE} ORDER BY id`);
+    const d = delta(start, client.getStats());
+    assert.strictEqual(d.statementsPrepared, 1);
+    assert.strictEqual(d.statementsEnded, 1);
+    assert.strictEqual(d.cursorsOpened, 1);
+    assert.strictEqual(d.rowsFetched, 2);
+    assert.deepStrictEqual(d.cells, {
+      null: 3, integer: 2, float: 0, boolean: 0, string: 1, binary: 1, lob: 1, other: 0,
+    });
+    assert.deepStrictEqual(d.bytes, { string: 3, buffer: 4, lob: 5 });
+  });
+
+  it('counts binds per type', async () => {
+    const start = client.getStats();
+    await client.query(`SELECT id FROM ${TABLE} WHERE id = ? OR name = ? OR data = ? OR id = ?`,
+      [1, 'abc', Buffer.from([1]), null]);
+    const d = delta(start, client.getStats());
+    assert.strictEqual(d.binds.integer, 1);
+    assert.strictEqual(d.binds.string, 1);
+    assert.strictEqual(d.binds.buffer, 1);
+    assert.strictEqual(d.binds.null, 1);
+  });
+
+  it('counts prepared statements, cursors and fetched rows', async () => {
+    const start = client.getStats();
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} ORDER BY id`);
+    await stmt.execute();
+    const cursor = await stmt.executeCursor();
+    for await (const row of cursor) {
+      assert.ok(row.id > 0);
+    }
+    await stmt.close();
+    const d = delta(start, client.getStats());
+    assert.strictEqual(d.statementsPrepared, 1);
+    assert.strictEqual(d.statementsEnded, 1);
+    assert.strictEqual(d.cursorsOpened, 2);
+    assert.strictEqual(d.rowsFetched, 4);
+  });
+
+  it('publishes the rows of a partly read cursor when it closes', async () => {
+    const start = client.getStats();
+    // reuseRow reads one row per next(), so the cursor stays partly read
+    const cursor = await client.queryCursor(
+      `SELECT id, name FROM ${TABLE} ORDER BY id`, [], { reuseRow: true }
+    );
+    assert.ok(await cursor.next());
+    await cursor.close();
+    const d = delta(start, client.getStats());
+    assert.strictEqual(d.rowsFetched, 1);
+    assert.strictEqual(d.cells.integer, 1);
+    assert.strictEqual(d.cells.string, 1);
+  });
+
+  it('counts rows of a prepared cursor on the owning connection', async () => {
+    const start = client.getStats();
+    const stmt = await client.prepare(`SELECT id, name FROM ${TABLE} ORDER BY id`);
+    const cursor = await stmt.executeCursor([], { reuseRow: true });
+    assert.ok(await cursor.next());
+    // Closing the statement detaches the open cursor
+    await stmt.close();
+    const d = delta(start, client.getStats());
+    assert.strictEqual(d.cursorsOpened, 1);
+    assert.strictEqual(d.rowsFetched, 1);
+    assert.strictEqual(d.cells.integer, 1);
+    assert.strictEqual(d.cells.string, 1);
+  });
+
+  it('adds every connection to the process totals', async () => {
+    const other = await createClient();
+    try {
+      const start = getStats();
+      await client.query(`SELECT id FROM ${TABLE}`);
+      await other.query(`SELECT id FROM ${TABLE}`);
+      const d = delta(start, getStats());
+      assert.ok(d.rowsFetched >= 4);
+      assert.ok(d.statementsPrepared >= 2);
+    } finally {
+      await other.close();
+    }
+  });
+});
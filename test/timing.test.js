@@ -0,0 +1,77 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+const PHASES = ['prepare', 'bind', 'execute', 'fetch', 'convert'];
+
+describe('phase timing', () => {
+  let client;
+  const TABLE = 'test_timing';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER, name NVARCHAR(50))`);
+    for (let i = 1; i <= 5; i++) {
+      await client.query(`INSERT INTO ${TABLE} VALUES (?, ?)`, [i, `name${i}`]);
+    }
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('is off by default', async () => {
+    const result = await client.query(`SELECT id FROM ${TABLE}`);
+    assert.strictEqual(result.timing, undefined);
+  });
+
+  it('reports each phase for a query', async () => {
+    const { timing } = await client.query(
+      `SELECT id, name FROM ${TABLE} WHERE id > ?`, [0], { timing: true }
+    );
+    for (const phase of PHASES) {
+      assert.ok(timing[phase] >= 0, phase);
+    }
+    const sum = PHASES.reduce((acc, phase) => acc + timing[phase], 0);
+    assert.ok(Math.abs(timing.total - sum) < 1e-6);
+    assert.strictEqual(timing.rows, 5);
+    assert.ok(timing.bytes > 0);
+  });
+
+  it('times prepared statements without a prepare phase', async () => {
+    const stmt = await client.prepare(`SELECT id FROM ${TABLE} WHERE id = ?`);
+    try {
+      const { timing } = await stmt.execute([3], { timing: true });
+      assert.strictEqual(timing.prepare, 0);
+      assert.strictEqual(timing.rows, 1);
+    } finally {
+      await stmt.close();
+    }
+  });
+
+  it('times DML statements', async () => {
+    const { timing } = await client.query(
+      `UPDATE ${TABLE} SET name = name WHERE id = 1`, [], { timing: true }
+    );
+    assert.strictEqual(timing.rows, 0);
+    assert.ok(timing.execute >= 0);
+  });
+
+  it('aggregates per connection when enabled at connect', async () => {
+    const timed = await createClient({ timing: true });
+    try {
+      await timed.query(`SELECT id FROM ${TABLE}`);
+      const { timing } = await timed.query(`SELECT id FROM ${TABLE} WHERE id < 3`);
+      assert.strictEqual(timing.rows, 2);
+
+      const stats = timed.timingStats(true);
+      assert.strictEqual(stats.statements, 2);
+      assert.strictEqual(stats.rows, 7);
+      assert.strictEqual(timed.timingStats().statements, 0);
+    } finally {
+      await timed.close();
+    }
+  });
+});
@@ -0,0 +1,155 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const diagnostics = require('node:diagnostics_channel');
+const { createClient, dropTable } = require('./helper');
+const { fingerprint } = require('../index');
+
+function record(operation) {
+  const events = [];
+  const channel = diagnostics.tracingChannel(`mimer:${operation}`);
+  const handlers = {
+    start: (ctx) => events.push(['start', ctx]),
+    end: () => {},
+    asyncStart: () => {},
+    asyncEnd: (ctx) => events.push(['asyncEnd', ctx]),
+    error: (ctx) => events.push(['error', ctx]),
+  };
+  channel.subscribe(handlers);
+  events.stop = () => channel.unsubscribe(handlers);
+  return events;
+}
+
+describe('fingerprint', () => {
+  it('replaces literals and collapses IN lists', () => {
+    assert.strictEqual(
+      fingerprint("SELECT *  FROM t1\n WHERE a = 'it''s' AND b IN (1, 2, 3) AND c > 1.5e3"),
+      'SELECT * FROM t1 WHERE a = ? AND b IN (?) AND c > ?'
+    );
+  });
+
+  it('drops comments', () => {
+    assert.strictEqual(fingerprint('SELECT 1 -- note\n/* x */ FROM t'), 'SELECT ? FROM t');
+  });
+
+  it('ignores quotes inside comments', () => {
+    assert.strictEqual(
+      fingerprint("SELECT a -- don't\nFROM t WHERE b = 'x'"),
+      'SELECT a FROM t WHERE b = ?'
+    );
+    assert.notStrictEqual(
+      fingerprint("SELECT a /* it's */ FROM t WHERE b = 'x'"),
+      fingerprint("SELECT a /* it's */ FROM u WHERE b = 'x'")
+    );
+  });
+
+  it('ignores comment markers inside literals', () => {
+    assert.strictEqual(
+      fingerprint("SELECT '--x', '/* y' FROM t WHERE c = 1"),
+      'SELECT ?, ? FROM t WHERE c = ?'
+    );
+  });
+});
+
+describe('tracing channels', { skip: typeof diagnostics.tracingChannel !== 'function' }, () => {
+  let client;
+  const TABLE = 'test_tracing';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(`CREATE TABLE ${TABLE} (id INTEGER)`);
+    await client.query(`INSERT INTO ${TABLE} VALUES (1)`);
+    await client.query(`INSERT INTO ${TABLE} VALUES (2)`);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('publishes query start and end with fingerprint and rowCount', async () => {
+    const events = record('query');
+    try {
+      await client.query(`SELECT id FROM ${TABLE} WHERE id > 0`, [], { timing: true });
+    } finally {
+      events.stop();
+    }
+    assert.deepStrictEqual(events.map((e) => e[0]), ['start', 'asyncEnd']);
+    const ctx = events[1][1];
+    assert.strictEqual(ctx.fingerprint, `SELECT id FROM ${TABLE} WHERE id > ?`);
+    assert.strictEqual(ctx.rowCount, 2);
+    assert.strictEqual(ctx.timing.rows, 2);
+  });
+
+  it('publishes errors', async () => {
+    const events = record('query');
+    try {
+      await assert.rejects(client.query('SELECT * FROM no_such_table_tracing'));
+    } finally {
+      events.stop();
+    }
+    const error = events.find((e) => e[0] === 'error');
+    assert.ok(error);
+    assert.ok(error[1].error instanceof Error);
+  });
+
+  it('publishes prepare, execute and fetch', async () => {
+    const prepares = record('prepare');
+    const executes = record('execute');
+    const fetches = record('fetch');
+    try {
+      const stmt = await client.prepare(`SELECT id FROM ${TABLE} WHERE id = ?`);
+      await stmt.execute([1]);
+      const cursor = await stmt.executeCursor([2]);
+      for await (const row of cursor) {
+        assert.strictEqual(row.id, 2);
+      }
+      await stmt.close();
+    } finally {
+      prepares.stop();
+      executes.stop();
+      fetches.stop();
+    }
+    assert.strictEqual(prepares.filter((e) => e[0] === 'start').length, 1);
+    assert.strictEqual(executes.filter((e) => e[0] === 'start').length, 2);
+    // The one-row batch ends the cursor, so the final next() is not traced
+    const rows = fetches.filter((e) => e[0] === 'asyncEnd').map((e) => e[1].rowCount);
+    assert.deepStrictEqual(rows, [1]);
+  });
+
+  it('publishes one fetch event per batch, not per row', async () => {
+    const fetches = record('fetch');
+    let count = 0;
+    try {
+      // 2^7 = 128 rows; the column name must not leak into the context
+      const cursor = await client.queryCursor(
+        `SELECT a.id AS "rowCount" FROM ${TABLE} a, ${TABLE} b, ${TABLE} c,
+           ${TABLE} d, ${TABLE} e, ${TABLE} f, ${TABLE} g`
+      );
+      for await (const row of cursor) {
+        count += row.rowCount > 0 ? 1 : 0;
+      }
+    } finally {
+      fetches.stop();
+    }
+    assert.strictEqual(count, 128);
+    const rows = fetches.filter((e) => e[0] === 'asyncEnd').map((e) => e[1].rowCount);
+    assert.deepStrictEqual(rows, [64, 64, 0]);
+  });
+
+  it('publishes commit and rollback', async () => {
+    const commits = record('commit');
+    const rollbacks = record('rollback');
+    try {
+      await client.beginTransaction();
+      await client.commit();
+      await client.beginTransaction();
+      await client.rollback();
+    } finally {
+      commits.stop();
+      rollbacks.stop();
+    }
+    assert.strictEqual(commits.length, 2);
+    assert.strictEqual(rollbacks.length, 2);
+  });
+});
@@ -0,0 +1,134 @@
+const { describe, it, before, after } = require('node:test');
+const assert = require('node:assert/strict');
+const { createClient, dropTable } = require('./helper');
+
+describe('watch queries', () => {
+  let client;
+  const TABLE = 'test_watch';
+
+  before(async () => {
+    client = await createClient();
+    await dropTable(client, TABLE);
+    await client.query(
+      `CREATE TABLE ${TABLE} (id INTEGER PRIMARY KEY, status NVARCHAR(20), region CHAR(2))`
+    );
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, [1, 'new', 'EU']);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, [2, 'new', 'EU']);
+    await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, [3, 'new', 'US']);
+  });
+
+  after(async () => {
+    await dropTable(client, TABLE);
+    await client.close();
+  });
+
+  it('requires a key column', () => {
+    assert.throws(() => client.watch(`SELECT * FROM ${TABLE}`, []), /key column/);
+  });
+
+  it('reports all rows as inserted on the first poll', async () => {
+    const watcher = client.watch(
+      `SELECT id, status FROM ${TABLE} WHERE region = ?`, ['EU'],
+      { key: 'id', intervalMs: 0 }
+    );
+    try {
+      const diff = await watcher.poll();
+      assert.deepStrictEqual(diff.inserted.map((r) => r.id).sort(), [1, 2]);
+      assert.strictEqual(diff.updated.length, 0);
+      assert.strictEqual(diff.deleted.length, 0);
+      assert.strictEqual(diff.rowCount, 2);
+    } finally {
+      watcher.close();
+    }
+  });
+
+  it('emits only inserted, updated and deleted rows', async () => {
+    const watcher = client.watch(
+      `SELECT id, status FROM ${TABLE} WHERE region = ?`, ['EU'],
+      { key: 'id', intervalMs: 0 }
+    );
+    try {
+      await watcher.poll();
+
+      const unchanged = await watcher.poll();
+      assert.strictEqual(unchanged.inserted.length, 0);
+      assert.strictEqual(unchanged.updated.length, 0);
+      assert.strictEqual(unchanged.deleted.length, 0);
+
+      await client.query(`UPDATE ${TABLE} SET status = ? WHERE id = ?`, ['shipped', 1]);
+      await client.query(`DELETE FROM ${TABLE} WHERE id = ?`, [2]);
+      await client.query(`INSERT INTO ${TABLE} VALUES (?, ?, ?)`, [4, 'new', 'EU']);
+
+      const changes = [];
+      watcher.on('change', (diff) => changes.push(diff));
+      const diff = await watcher.poll();
+
+      assert.strictEqual(changes.length, 1);
+      assert.deepStrictEqual(diff.inserted, [{ id: 4, status: 'new' }]);
+      assert.deepStrictEqual(diff.updated, [{ id: 1, status: 'shipped' }]);
+      assert.deepStrictEqual(diff.deleted, [2]);
+    } finally {
+      watcher.close();
+    }
+  });
+
+  it('does not emit change when nothing changed', async () => {
+    const watcher = client.watch(`SELECT id, status FROM ${TABLE}`, [],
+      { key: 'id', intervalMs: 0 });
+    try {
+      await watcher.poll();
+      let emitted = false;
+      watcher.on('change', () => { emitted = true; });
+      await watcher.poll();
+      assert.strictEqual(emitted, false);
+    } finally {
+      watcher.close();
+    }
+  });
+
+  it('polls on the interval', async () => {
+    const watcher = client.watch(`SELECT id, status FROM ${TABLE}`, [],
+      { key: 'id', intervalMs: 10 });
+    try {
+      const diff = await new Promise((resolve, reject) => {
+        watcher.once('change', resolve);
+        watcher.once('error', reject);
+      });
+      assert.ok(diff.inserted.length > 0);
+    } finally {
+      watcher.close();
+    }
+  });
+
+  it('keeps polling without an error listener', async () => {
+    const watcher = client.watch(`SELECT id, status FROM ${TABLE}`, [],
+      { key: 'missing', intervalMs: 5 });
+    const rejections = [];
+    const onRejection = (reason) => rejections.push(reason);
+    process.on('unhandledRejection', onRejection);
+    let polls = 0;
+    const poll = watcher.poll.bind(watcher);
+    watcher.poll = () => {
+      polls++;
+      return poll();
+    };
+    try {
+      await new Promise((resolve) => setTimeout(resolve, 100));
+      assert.ok(polls >= 2);
+      assert.deepStrictEqual(rejections, []);
+    } finally {
+      process.off('unhandledRejection', onRejection);
+      watcher.close();
+    }
+  });
+
+  it('rejects an unknown key column', async () => {
+    const watcher = client.watch(`SELECT id, status FROM ${TABLE}`, [],
+      { key: 'missing', intervalMs: 0 });
+    try {
+      await assert.rejects(() => watcher.poll(), /missing/);
+    } finally {
+      watcher.close();
+    }
+  });
+});